@@ -0,0 +1,85 @@
+#include "AsyncOutputBuffer.h"
+
+#include <utility>
+
+namespace {
+    constexpr std::size_t ChunkSize = 1 << 20;
+
+    // bounds the memory if the target is slower than the output grows
+    constexpr std::size_t MaxQueuedChunks = 16;
+}
+
+AsyncOutputBuffer::AsyncOutputBuffer(std::streambuf* target)
+    : m_target(target),
+      m_buffer(std::make_unique_for_overwrite<char[]>(ChunkSize)) {
+    setp(m_buffer.get(), m_buffer.get() + ChunkSize);
+    m_writer = std::thread(&AsyncOutputBuffer::Write, this);
+}
+
+AsyncOutputBuffer::~AsyncOutputBuffer() {
+    Submit(true);
+    {
+        std::scoped_lock lock(m_mutex);
+        m_stop = true;
+    }
+    m_queued.notify_one();
+    m_writer.join();
+}
+
+AsyncOutputBuffer::int_type AsyncOutputBuffer::overflow(int_type c) {
+    Submit(false);
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+int AsyncOutputBuffer::sync() {
+    Submit(true);
+    return 0;
+}
+
+void AsyncOutputBuffer::Submit(bool flush) {
+    auto size = static_cast<std::size_t>(pptr() - pbase());
+    if (size == 0 && !flush) {
+        return;
+    }
+
+    std::unique_lock lock(m_mutex);
+    m_written.wait(lock, [this] { return m_queue.size() < MaxQueuedChunks; });
+    m_queue.push_back({ std::move(m_buffer), size, flush });
+    if (!m_spare.empty()) {
+        m_buffer = std::move(m_spare.back());
+        m_spare.pop_back();
+    }
+    lock.unlock();
+    m_queued.notify_one();
+
+    if (!m_buffer) {
+        m_buffer = std::make_unique_for_overwrite<char[]>(ChunkSize);
+    }
+    setp(m_buffer.get(), m_buffer.get() + ChunkSize);
+}
+
+void AsyncOutputBuffer::Write() {
+    std::unique_lock lock(m_mutex);
+    for (;;) {
+        m_queued.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty()) {
+            return;
+        }
+        auto chunk = std::move(m_queue.front());
+        m_queue.pop_front();
+
+        lock.unlock();
+        m_target->sputn(chunk.data.get(), static_cast<std::streamsize>(chunk.size));
+        if (chunk.flush) {
+            m_target->pubsync();
+        }
+        lock.lock();
+
+        m_spare.push_back(std::move(chunk.data));
+        m_written.notify_one();
+    }
+}
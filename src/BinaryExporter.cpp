@@ -0,0 +1,116 @@
+#include "Block.h"
+#include "BinaryExporter.h"
+#include "BinaryReport.h"
+#include "HashUtil.h"
+
+#include <iostream>
+
+BinaryExporter::BinaryExporter(const Options& options)
+    : FileExporter(options, false) {
+}
+
+void BinaryExporter::LogMessage(const std::string& message) {
+    Log() << message << std::flush;
+}
+
+void BinaryExporter::WriteHeader() {
+    m_buffer.assign(BinaryReport::MAGIC);
+    BinaryReport::AppendNumber(m_buffer, BinaryReport::VERSION);
+    Out() << m_buffer;
+}
+
+void BinaryExporter::WriteFooter(
+    const Options& /*options*/,
+    int /*files*/,
+    long /*locsTotal*/,
+    unsigned /*tot_dup_blocks*/,
+    unsigned /*tot_dup_lines*/) {
+    Out() << static_cast<char>(BinaryReport::Record::End);
+}
+
+std::uint32_t BinaryExporter::GetFileId(const SourceFile& source) {
+    auto [it, inserted] = m_fileIds.try_emplace(&source, static_cast<std::uint32_t>(m_fileIds.size()));
+    if (inserted) {
+        m_buffer += static_cast<char>(BinaryReport::Record::File);
+        BinaryReport::AppendString(m_buffer, source.GetFilename());
+    }
+    return it->second;
+}
+
+std::uint32_t BinaryExporter::GetTextId(const SourceFile& source, int line, int count) {
+    std::uint64_t hash = HashUtil::SEED;
+    for (int j = 0; j < count; j++) {
+        auto text = source.GetLine(line + j).GetLine();
+        hash = HashUtil::Mix(hash ^ HashUtil::SECRET0, HashUtil::Hash(text.data(), text.size()));
+    }
+
+    auto [first, last] = m_textIds.equal_range(hash);
+    for (auto it = first; it != last; ++it) {
+        auto const& text = m_texts[it->second];
+        if (text.count != count) {
+            continue;
+        }
+        int j = 0;
+        while (j < count && source.GetLine(line + j).GetLine() == text.source->GetLine(text.line + j).GetLine()) {
+            j++;
+        }
+        if (j == count) {
+            return it->second;
+        }
+    }
+
+    auto id = static_cast<std::uint32_t>(m_texts.size());
+    m_texts.push_back({ &source, line, count });
+    m_textIds.emplace(hash, id);
+    m_buffer += static_cast<char>(BinaryReport::Record::Text);
+    BinaryReport::AppendNumber(m_buffer, count);
+    for (int j = 0; j < count; j++) {
+        BinaryReport::AppendString(m_buffer, source.GetLine(line + j).GetLine());
+    }
+    return id;
+}
+
+void BinaryExporter::ReportSeq(
+    int line1,
+    int line2,
+    int count,
+    const SourceFile& source1,
+    const SourceFile& source2) {
+    // the files and the text are written first when they are new
+    m_buffer.clear();
+    auto file1 = GetFileId(source1);
+    auto file2 = GetFileId(source2);
+    auto text = GetTextId(source1, line1, count);
+
+    m_buffer += static_cast<char>(BinaryReport::Record::Block);
+    BinaryReport::AppendNumber(m_buffer, text);
+    BinaryReport::AppendNumber(m_buffer, file1);
+    BinaryReport::AppendNumber(m_buffer, source1.GetLineNumber(line1));
+    BinaryReport::AppendNumber(m_buffer, source1.GetLineNumber(line1 + count - 1));
+    BinaryReport::AppendNumber(m_buffer, file2);
+    BinaryReport::AppendNumber(m_buffer, source2.GetLineNumber(line2));
+    BinaryReport::AppendNumber(m_buffer, source2.GetLineNumber(line2 + count - 1));
+    Out() << m_buffer;
+}
+
+void BinaryExporter::ReportClass(const CloneClass& cloneClass) {
+    m_buffer.clear();
+    std::vector<std::uint32_t> files;
+    files.reserve(cloneClass.m_locations.size());
+    for (auto const& location : cloneClass.m_locations) {
+        files.push_back(GetFileId(*location.m_source));
+    }
+    auto const& first = cloneClass.m_locations.front();
+    auto text = GetTextId(*first.m_source, first.m_line, cloneClass.m_count);
+
+    m_buffer += static_cast<char>(BinaryReport::Record::Class);
+    BinaryReport::AppendNumber(m_buffer, text);
+    BinaryReport::AppendNumber(m_buffer, cloneClass.m_locations.size());
+    for (std::size_t i = 0; i < files.size(); i++) {
+        auto const& location = cloneClass.m_locations[i];
+        BinaryReport::AppendNumber(m_buffer, files[i]);
+        BinaryReport::AppendNumber(m_buffer, location.m_source->GetLineNumber(location.m_line));
+        BinaryReport::AppendNumber(m_buffer, location.m_source->GetLineNumber(location.m_line + cloneClass.m_count - 1));
+    }
+    Out() << m_buffer;
+}
@@ -0,0 +1,59 @@
+#include "BinaryReport.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+    char ReadByte(std::istream& in) {
+        char c;
+        if (!in.get(c)) {
+            throw std::runtime_error("Error: Unexpected end of report");
+        }
+        return c;
+    }
+}
+
+void BinaryReport::AppendNumber(std::string& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+void BinaryReport::AppendString(std::string& out, std::string_view text) {
+    AppendNumber(out, text.size());
+    out.append(text);
+}
+
+std::uint64_t BinaryReport::ReadNumber(std::istream& in) {
+    std::uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        auto byte = static_cast<unsigned char>(ReadByte(in));
+        value |= std::uint64_t(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw std::runtime_error("Error: Invalid number in report");
+}
+
+std::string BinaryReport::ReadString(std::istream& in) {
+    auto length = ReadNumber(in);
+    std::string text;
+    // read in pieces, so that a broken length fails before it is allocated
+    char buffer[4096];
+    while (length > 0) {
+        auto piece = static_cast<std::streamsize>(std::min<std::uint64_t>(length, sizeof(buffer)));
+        if (!in.read(buffer, piece)) {
+            throw std::runtime_error("Error: Unexpected end of report");
+        }
+        text.append(buffer, static_cast<std::size_t>(piece));
+        length -= static_cast<std::uint64_t>(piece);
+    }
+    return text;
+}
+
+BinaryReport::Record BinaryReport::ReadRecord(std::istream& in) {
+    return static_cast<Record>(ReadByte(in));
+}
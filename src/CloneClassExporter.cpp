@@ -0,0 +1,121 @@
+#include "CloneClassExporter.h"
+#include "HashUtil.h"
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace {
+    // the lines of a block at one of its ends
+    struct Fragment {
+        SourceFile const* source;
+        unsigned line;
+        unsigned count;
+
+        bool operator==(const Fragment& other) const = default;
+    };
+
+    struct FragmentHash {
+        std::size_t operator()(const Fragment& fragment) const {
+            auto source = reinterpret_cast<std::uintptr_t>(fragment.source);
+            auto position = (std::uint64_t(fragment.line) << 32) | fragment.count;
+            return static_cast<std::size_t>(HashUtil::Mix(source ^ HashUtil::SECRET0, position ^ HashUtil::SECRET1));
+        }
+    };
+
+    // union-find with the first fragment of a class as its root
+    class DisjointSets {
+        std::vector<unsigned> m_parent;
+
+    public:
+        unsigned Add() {
+            m_parent.push_back(static_cast<unsigned>(m_parent.size()));
+            return m_parent.back();
+        }
+
+        unsigned Find(unsigned x) {
+            while (m_parent[x] != x) {
+                m_parent[x] = m_parent[m_parent[x]];
+                x = m_parent[x];
+            }
+            return x;
+        }
+
+        void Union(unsigned a, unsigned b) {
+            a = Find(a);
+            b = Find(b);
+            if (a < b) {
+                m_parent[b] = a;
+            } else if (b < a) {
+                m_parent[a] = b;
+            }
+        }
+    };
+}
+
+CloneClassExporter::CloneClassExporter(IExporterPtr exporter)
+    : m_exporter(std::move(exporter)) {
+}
+
+void CloneClassExporter::LogMessage(const std::string& message) {
+    m_exporter->LogMessage(message);
+}
+
+void CloneClassExporter::WriteHeader() {
+    m_exporter->WriteHeader();
+}
+
+void CloneClassExporter::WriteFooter(
+    const Options& options,
+    int files,
+    long locsTotal,
+    unsigned tot_dup_blocks,
+    unsigned tot_dup_lines) {
+    std::vector<Fragment> fragments;
+    std::unordered_map<Fragment, unsigned, FragmentHash> ids;
+    DisjointSets sets;
+    auto getId = [&](const Fragment& fragment) {
+        auto [it, inserted] = ids.try_emplace(fragment, 0);
+        if (inserted) {
+            it->second = sets.Add();
+            fragments.push_back(fragment);
+        }
+        return it->second;
+    };
+    for (auto const& block : m_blocks) {
+        auto id1 = getId({ block.m_source1, block.m_line1, block.m_count });
+        auto id2 = getId({ block.m_source2, block.m_line2, block.m_count });
+        sets.Union(id1, id2);
+    }
+    m_blocks = {};
+
+    // classes in the order their first block was reported, the locations
+    // in the order they were first seen
+    std::vector<CloneClass> classes;
+    std::vector<unsigned> classOfRoot(fragments.size(), 0);
+    for (unsigned id = 0; id < fragments.size(); id++) {
+        auto root = sets.Find(id);
+        if (root == id) {
+            classOfRoot[root] = static_cast<unsigned>(classes.size());
+            classes.push_back({ {}, fragments[id].count });
+        }
+        classes[classOfRoot[root]].m_locations.push_back({ fragments[id].source, fragments[id].line });
+    }
+
+    for (auto const& cloneClass : classes) {
+        m_exporter->ReportClass(cloneClass);
+    }
+    m_exporter->WriteFooter(options, files, locsTotal, tot_dup_blocks, tot_dup_lines);
+}
+
+void CloneClassExporter::ReportSeq(
+    int line1,
+    int line2,
+    int count,
+    const SourceFile& source1,
+    const SourceFile& source2) {
+    m_blocks.emplace_back(&source1, &source2, line1, line2, count);
+}
+
+void CloneClassExporter::ReportClass(const CloneClass& cloneClass) {
+    m_exporter->ReportClass(cloneClass);
+}
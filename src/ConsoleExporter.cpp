@@ -4,6 +4,23 @@
 
 #include <iostream>
 
+namespace {
+    void WriteLocation(std::ostream& out, const SourceFile& source, int line) {
+        out
+            << source.GetFilename()
+            << "(" << source.GetLineNumber(line) << ")"
+            << '\n';
+    }
+
+    void WriteLines(std::ostream& out, const SourceFile& source, int line, int count) {
+        for (int j = 0; j < count; j++) {
+            out << source.GetLine(j + line).GetLine() << '\n';
+        }
+
+        out << '\n';
+    }
+}
+
 ConsoleExporter::ConsoleExporter(const Options& options)
     : FileExporter(options, true) {
 }
@@ -21,36 +38,36 @@ void ConsoleExporter::WriteFooter(
     unsigned tot_dup_lines) {
     Out()
         << "Configuration:"
-        << std::endl
+        << '\n'
         << "  Number of files: "
         << files
-        << std::endl
+        << '\n'
         << "  Minimal block size: "
         << options.GetMinBlockSize()
-        << std::endl
+        << '\n'
         << "  Minimal characters in line: "
         << options.GetMinChars()
-        << std::endl
+        << '\n'
         << "  Ignore preprocessor directives: "
         << options.GetIgnorePrepStuff()
-        << std::endl
+        << '\n'
         << "  Ignore same filenames: "
         << options.GetIgnoreSameFilename()
-        << std::endl
-        << std::endl
+        << '\n'
+        << '\n'
         << "Results:"
-        << std::endl
+        << '\n'
         << "  Lines of code: "
         << locsTotal
-        << std::endl
+        << '\n'
         << "  Duplicate lines of code: "
         << tot_dup_lines
-        << std::endl
+        << '\n'
         << "  Total "
         << tot_dup_blocks
         << " duplicate block(s) found."
-        << std::endl
-        << std::endl;
+        << '\n'
+        << '\n';
 }
 
 void ConsoleExporter::ReportSeq(
@@ -59,17 +76,15 @@ void ConsoleExporter::ReportSeq(
     int count,
     const SourceFile& source1,
     const SourceFile& source2) {
-    Out()
-        << source1.GetFilename()
-        << "(" << source1.GetLine(line1).GetLineNumber() << ")"
-        << std::endl;
-    Out()
-        << source2.GetFilename()
-        << "(" << source2.GetLine(line2).GetLineNumber() << ")"
-        << std::endl;
-    for (int j = 0; j < count; j++) {
-        Out() << source1.GetLine(j + line1).GetLine() << std::endl;
-    }
+    WriteLocation(Out(), source1, line1);
+    WriteLocation(Out(), source2, line2);
+    WriteLines(Out(), source1, line1, count);
+}
 
-    Out() << std::endl;
+void ConsoleExporter::ReportClass(const CloneClass& cloneClass) {
+    for (auto const& location : cloneClass.m_locations) {
+        WriteLocation(Out(), *location.m_source, location.m_line);
+    }
+    auto const& first = cloneClass.m_locations.front();
+    WriteLines(Out(), *first.m_source, first.m_line, cloneClass.m_count);
 }
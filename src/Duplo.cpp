@@ -1,18 +1,30 @@
 #include "Duplo.h"
+#include "FingerprintCache.h"
 #include "IExporter.h"
+#include "LineKernel.h"
+#include "MatchMatrix.h"
 #include "Options.h"
+#include "PostingIndex.h"
 #include "Block.h"
 #include "SourceFile.h"
 #include "SourceLine.h"
+#include "SuffixArray.h"
 #include "Utils.h"
+#include "WindowIndex.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <deque>
+#include <filesystem>
 #include <ctime>
-#include <cmath>
 #include <format>
+#include <future>
 #include <iostream>
-#include <sstream>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <queue>
 #include <unordered_map>
 #include <unordered_set>
 #include <thread>
@@ -20,102 +32,416 @@
 
 #include <BS_thread_pool.hpp>
 
-typedef std::tuple<unsigned, std::string> FileLength;
-typedef const std::string* StringPtr;
-typedef std::unordered_map<unsigned long, std::vector<StringPtr>> HashToFiles;
+typedef std::unordered_map<std::uint64_t, std::vector<unsigned>> LineIndex;
+typedef std::unordered_set<std::uint64_t> StopLines;
 using thread_pool = BS::thread_pool<>;
 
-static constexpr std::size_t TOP_N_LONGEST = 10;
+// Number of the most common stop lines that are logged.
+static constexpr std::size_t TOP_N_STOP_LINES = 10;
+
+// Every thread gets about this many chunks of comparisons to balance the load.
+static constexpr std::size_t CHUNKS_PER_THREAD = 8;
+
+// Pairs with fewer than 1/DENSE_MATCH_RATIO matching cells are walked sparsely.
+static constexpr std::size_t DENSE_MATCH_RATIO = 16;
+
+// State of the run currently being extended along one diagonal.
+struct DiagonalRun {
+    unsigned end;
+    unsigned length;
+};
+
+// Blocks of one chunk in the buffer of the thread that processed it.
+struct BlockRange {
+    std::size_t left;
+    std::size_t slot;
+    std::size_t first;
+    std::size_t last;
+};
 
 struct ThreadContext {
-    std::vector<bool> matrix;
+    MatchMatrix matrix;
+    std::vector<std::uint64_t> hashes1;
+    std::vector<std::uint64_t> hashes2;
+    std::vector<DiagonalRun> runs;
+    std::vector<DiagonalBlock> diagonal_blocks;
     std::vector<Block> dup_blocks;
+    std::vector<BlockRange> ranges;
+    std::vector<unsigned> shared_lines;
+    std::vector<unsigned> shared_epochs;
+    std::vector<unsigned> touched_files;
+    const StopLines* stop_lines;
+    bool verify;
     std::size_t num_dup_lines;
     std::size_t num_dup_blocks;
 };
 
+// Consecutive comparisons of one file that are processed by a single task.
+struct Chunk {
+    std::size_t left;
+    std::size_t slot;
+    std::size_t first;
+    std::size_t last;
+    std::uint64_t cost;
+};
+
+// Comparisons of one file, shared by all of its chunks.
+struct LeftFile {
+    std::vector<std::size_t> candidates;
+    std::vector<std::uint64_t> costs;
+    std::once_flag index_flag;
+    LineIndex index;
+    std::atomic<std::size_t> pending;
+};
+
+// Comparisons of a file with the files that were loaded before it.
+struct LaterFile {
+    const SourceFile* source;
+    std::vector<const SourceFile*> earlier;
+    std::vector<Block> blocks;
+    bool done = false;
+};
+
+// Files loaded so far that contain a line, with its number of lines there.
+typedef std::unordered_map<std::uint64_t, std::vector<PostingIndex::Posting>> IncrementalIndex;
+
+// Next block range of a thread to merge: file, chunk slot, thread, range.
+typedef std::tuple<std::size_t, std::size_t, std::size_t, std::size_t> MergeHead;
+
 namespace {
-    void printLongestFiles(std::ostringstream &oss, std::vector<SourceFile> &sourceFiles, std::size_t top_n) {
-        std::sort(std::begin(sourceFiles),
-                  std::end(sourceFiles),
-                  [](SourceFile const& l, SourceFile const& r) {
-            return l.GetNumOfLines() > r.GetNumOfLines();
-        });
-        std::for_each_n(std::begin(sourceFiles), top_n, [&oss](SourceFile const& file) {
-            oss << file.GetNumOfLines() << ": " << file.GetFilename() << '\n';
-        });
+    std::string NormalizePath(const std::string& filename) {
+        return std::filesystem::path(filename).lexically_normal().generic_string();
     }
 
-    std::tuple<std::vector<SourceFile>, unsigned, unsigned, std::size_t> LoadSourceFiles(
+    std::unordered_set<std::string> AddChangedFiles(std::vector<std::string>& lines, const std::string& changedListFilename) {
+        std::unordered_set<std::string> listed;
+        for (auto const& line : lines) {
+            listed.insert(NormalizePath(line));
+        }
+
+        // changed files that are not listed are added, unless they were deleted
+        std::unordered_set<std::string> changed;
+        for (auto const& line : FileSystem::LoadFileList(changedListFilename)) {
+            if (line.empty()) {
+                continue;
+            }
+            auto path = NormalizePath(line);
+            changed.insert(path);
+            if (!listed.contains(path) && std::filesystem::exists(line)) {
+                lines.push_back(line);
+                listed.insert(path);
+            }
+        }
+        return changed;
+    }
+
+    /**
+     * Waits for all tasks and then throws the first of their errors, as the
+     * tasks refer to data of the caller. Detached tasks would lose errors
+     * of a worker thread, such as a file that changed since it was loaded.
+     */
+    void WaitForTasks(BS::multi_future<void>& tasks) {
+        tasks.wait();
+        tasks.get();
+    }
+
+    std::tuple<std::vector<SourceFile>, unsigned, unsigned> LoadSourceFiles(
         const std::vector<std::string>& lines,
         unsigned minChars,
         bool ignorePrepStuff,
-        unsigned numThreads,
+        const FingerprintCache* cache,
+        thread_pool& pool,
         IExporterPtr exporter) {
 
+        // every file is loaded into its own slot, so the order stays the same
+        std::vector<std::optional<SourceFile>> slots(lines.size());
+        auto loads = pool.submit_loop(std::size_t(0), lines.size(), [&lines, &slots, minChars, ignorePrepStuff, cache](std::size_t i) {
+            if (lines[i].size() > 5) {
+                slots[i].emplace(lines[i], minChars, ignorePrepStuff, cache);
+            }
+        });
+        WaitForTasks(loads);
+
         std::vector<SourceFile> sourceFiles;
-        size_t maxLinesPerFile = 0;
         int files = 0;
         unsigned long locsTotal = 0;
 
         // Create vector with all source files
-        for (size_t i = 0; i < lines.size(); i++) {
-            if (lines[i].size() > 5) {
-                SourceFile sourceFile(lines[i], minChars, ignorePrepStuff);
-                size_t numLines = sourceFile.GetNumOfLines();
-                if (numLines > 0) {
-                    files++;
-                    sourceFiles.push_back(std::move(sourceFile));
-                    locsTotal += numLines;
-                    if (maxLinesPerFile < numLines) {
-                        maxLinesPerFile = numLines;
-                    }
+        for (auto& slot : slots) {
+            if (slot && slot->GetNumOfLines() > 0) {
+                files++;
+                locsTotal += slot->GetNumOfLines();
+                sourceFiles.push_back(std::move(*slot));
+            }
+        }
+
+        exporter->LogMessage(std::format("{} done.\n\n", lines.size()));
+
+        return std::tuple(std::move(sourceFiles), files, locsTotal);
+    }
+
+    LineIndex BuildLineIndex(const SourceFile& source) {
+        LineIndex index;
+        for (size_t i = 0; i < source.GetNumOfLines(); i++) {
+            index[source.GetHash(i)].push_back(i);
+        }
+        return index;
+    }
+
+    void AddBlock(
+        const SourceFile& source1,
+        const SourceFile& source2,
+        unsigned line1,
+        unsigned line2,
+        unsigned count,
+        ThreadContext& context) {
+        // a block of common lines only would not have made the files compared
+        if (!context.stop_lines->empty()) {
+            bool common = true;
+            for (unsigned i = line1; common && i < line1 + count; i++) {
+                common = context.stop_lines->contains(source1.GetHash(i));
+            }
+            if (common) {
+                return;
+            }
+        }
+
+        context.dup_blocks.emplace_back(&source1, &source2, line1, line2, count);
+        context.num_dup_lines += count;
+        ++context.num_dup_blocks;
+    }
+
+    /**
+     * Calls f for the parts of a block whose lines have the same text and
+     * not only the same hash, parts shorter than minBlockSize are dropped.
+     */
+    template <typename F>
+    void ForEachVerifiedPart(
+        const SourceFile& source1,
+        const SourceFile& source2,
+        unsigned line1,
+        unsigned line2,
+        unsigned count,
+        unsigned minBlockSize,
+        F f) {
+        unsigned start = 0;
+        for (unsigned i = 0; i <= count; i++) {
+            if (i == count || !LineKernel::EqualNonBlank(source1.GetLine(line1 + i).GetLine(), source2.GetLine(line2 + i).GetLine())) {
+                if (i - start >= minBlockSize) {
+                    f(line1 + start, line2 + start, i - start);
                 }
+                start = i + 1;
             }
         }
+    }
 
-        auto const max_size = std::vector<bool>().max_size();
-        if (numThreads * maxLinesPerFile * maxLinesPerFile > max_size) {
-            std::ostringstream stream;
-            stream
-                << "Some files have too many lines, or you're using too many threads.\n"
-                << "Using " << numThreads << " thread(s), you can have files with approximately "
-                << std::sqrt((double)max_size / numThreads) << " lines at most.\n"
-                << "Longest files:\n";
-            printLongestFiles(stream, sourceFiles, TOP_N_LONGEST);
-            throw std::runtime_error(stream.str().c_str());
+    void VerifyBlocks(std::vector<Block>& blocks, unsigned minBlockSize) {
+        std::vector<Block> verified;
+        for (auto const& block : blocks) {
+            auto const& source1 = *block.m_source1;
+            auto const& source2 = *block.m_source2;
+            ForEachVerifiedPart(source1, source2, block.m_line1, block.m_line2, block.m_count, minBlockSize,
+                [&](unsigned line1, unsigned line2, unsigned count) {
+                    verified.emplace_back(&source1, &source2, line1, line2, count);
+                });
         }
+        blocks = std::move(verified);
+    }
 
-        exporter->LogMessage(std::format("{} done.\n\n", lines.size()));
+    /**
+     * Removes the blocks from first on whose lines lie within a longer
+     * block of the same file pair in both files. A repeat in a file matches
+     * itself on nearby diagonals, only the block of the shortest distance
+     * covers all of them and is kept. The order of the other blocks stays
+     * the same, returns the number of lines that were removed.
+     */
+    std::size_t PruneBlocks(std::vector<Block>& blocks, std::size_t first) {
+        std::vector<std::size_t> order(blocks.size() - first);
+        std::iota(order.begin(), order.end(), first);
+        auto before = [](const SourceFile* l, const SourceFile* r) {
+            return std::less<const SourceFile*>()(l, r);
+        };
+        std::sort(order.begin(), order.end(), [&blocks, &before](std::size_t l, std::size_t r) {
+            auto const& a = blocks[l];
+            auto const& b = blocks[r];
+            if (a.m_source1 != b.m_source1) {
+                return before(a.m_source1, b.m_source1);
+            }
+            if (a.m_source2 != b.m_source2) {
+                return before(a.m_source2, b.m_source2);
+            }
+            // a block that contains another comes first
+            return std::tie(a.m_line1, b.m_count, a.m_line2) < std::tie(b.m_line1, a.m_count, b.m_line2);
+        });
+
+        // kept blocks of the pair that reach the start of the current one in
+        // the first file, anything within a removed block is within these
+        std::vector<std::size_t> active;
+        std::vector<bool> removed(blocks.size() - first, false);
+        std::size_t removedLines = 0;
+        for (std::size_t i = 0; i < order.size(); i++) {
+            auto const& block = blocks[order[i]];
+            if (i > 0) {
+                auto const& previous = blocks[order[i - 1]];
+                if (block.m_source1 != previous.m_source1 || block.m_source2 != previous.m_source2) {
+                    active.clear();
+                }
+            }
+            std::erase_if(active, [&blocks, &block](std::size_t k) {
+                return blocks[k].m_line1 + blocks[k].m_count <= block.m_line1;
+            });
+            bool contained = std::any_of(active.begin(), active.end(), [&blocks, &block](std::size_t k) {
+                auto const& longer = blocks[k];
+                return block.m_line1 + block.m_count <= longer.m_line1 + longer.m_count
+                    && longer.m_line2 <= block.m_line2
+                    && block.m_line2 + block.m_count <= longer.m_line2 + longer.m_count;
+            });
+            if (contained) {
+                removed[order[i] - first] = true;
+                removedLines += block.m_count;
+            } else {
+                active.push_back(order[i]);
+            }
+        }
 
-        return std::tuple(std::move(sourceFiles), files, locsTotal, maxLinesPerFile);
+        std::size_t kept = first;
+        for (std::size_t i = first; i < blocks.size(); i++) {
+            if (!removed[i - first]) {
+                blocks[kept++] = blocks[i];
+            }
+        }
+        blocks.erase(blocks.begin() + kept, blocks.end());
+        return removedLines;
     }
 
-    void Process(
+    void AddDiagonalBlocks(
         const SourceFile& source1,
         const SourceFile& source2,
-        const Options& options,
-        ThreadContext &context) {
+        unsigned minBlockSize,
+        ThreadContext& context) {
+        unsigned m = source1.GetNumOfLines();
+        for (auto const& block : context.diagonal_blocks) {
+            unsigned line1 = block.diagonal < m ? block.diagonal + block.start : block.start;
+            unsigned line2 = block.diagonal < m ? block.start : block.diagonal - m + block.start;
+            if (context.verify) {
+                ForEachVerifiedPart(source1, source2, line1, line2, block.length, minBlockSize,
+                    [&](unsigned verified1, unsigned verified2, unsigned count) {
+                        AddBlock(source1, source2, verified1, verified2, count, context);
+                    });
+            } else {
+                AddBlock(source1, source2, line1, line2, block.length, context);
+            }
+        }
+    }
 
-        // unwrap the context
-        auto &[matrix, dup_blocks, num_dup_lines, num_dup_blocks] = context;
+    /**
+     * Finds the blocks of a file pair by visiting only the matching lines,
+     * see DiagonalBlock for how the diagonals are numbered.
+     */
+    void ProcessSparse(
+        const SourceFile& source1,
+        const SourceFile& source2,
+        const LineIndex& index1,
+        unsigned minBlockSize,
+        ThreadContext& context) {
 
-        size_t m = source1.GetNumOfLines();
-        size_t n = source2.GetNumOfLines();
+        unsigned m = source1.GetNumOfLines();
+        unsigned n = source2.GetNumOfLines();
+        bool sameFile = source1 == source2;
+
+        auto& runs = context.runs;
+        auto& diagonal_blocks = context.diagonal_blocks;
+        runs.assign(m + n, DiagonalRun{ 0, 0 });
+        diagonal_blocks.clear();
 
-        // Reset matrix data
-        std::fill(std::begin(matrix), std::begin(matrix) + m * n, false);
+        auto closeRun = [&](unsigned diagonal, DiagonalRun const& run) {
+            if (run.length > 0 && run.length >= minBlockSize) {
+                diagonal_blocks.push_back({ diagonal, run.end - run.length, run.length });
+            }
+        };
 
-        // Compute matrix
-        for (size_t y = 0; y < m; y++) {
-            auto& line = source1.GetLine(y);
-            for (size_t x = 0; x < n; x++) {
-                if (line == source2.GetLine(x)) {
-                    matrix[x + n * y] = true;
+        // Lines of source2 are visited in order, so every diagonal is walked
+        // in increasing position and runs can be extended in place.
+        for (unsigned x = 0; x < n; x++) {
+            auto it = index1.find(source2.GetHash(x));
+            if (it == index1.end()) {
+                continue;
+            }
+
+            for (unsigned y : it->second) {
+                unsigned diagonal;
+                unsigned pos;
+                if (y >= x) {
+                    if (sameFile && y == x) {
+                        continue;
+                    }
+                    diagonal = y - x;
+                    pos = x;
+                } else {
+                    if (sameFile) {
+                        continue;
+                    }
+                    diagonal = m + x - y;
+                    pos = y;
+                }
+
+                auto& run = runs[diagonal];
+                if (run.length > 0 && run.end == pos) {
+                    run.length++;
+                } else {
+                    closeRun(diagonal, run);
+                    run.length = 1;
                 }
+                run.end = pos + 1;
             }
         }
 
+        for (unsigned diagonal = 0; diagonal < runs.size(); diagonal++) {
+            closeRun(diagonal, runs[diagonal]);
+        }
+
+        std::sort(std::begin(diagonal_blocks), std::end(diagonal_blocks));
+        AddDiagonalBlocks(source1, source2, minBlockSize, context);
+    }
+
+    void ProcessDense(
+        const SourceFile& source1,
+        const SourceFile& source2,
+        unsigned lMinBlockSize,
+        ThreadContext &context) {
+
+        size_t m = source1.GetNumOfLines();
+        size_t n = source2.GetNumOfLines();
+        bool sameFile = source1 == source2;
+
+        // the hashes along a diagonal are compared as contiguous arrays
+        auto gather = [](const SourceFile& source, std::vector<std::uint64_t>& hashes) {
+            hashes.resize(source.GetNumOfLines());
+            for (size_t i = 0; i < hashes.size(); i++) {
+                hashes[i] = source.GetHash(i);
+            }
+        };
+        gather(source1, context.hashes1);
+        if (!sameFile) {
+            gather(source2, context.hashes2);
+        }
+        auto const& hashes2 = sameFile ? context.hashes1 : context.hashes2;
+
+        context.diagonal_blocks.clear();
+        context.matrix.FindRuns(context.hashes1.data(), m, hashes2.data(), n, sameFile, lMinBlockSize, context.diagonal_blocks);
+        AddDiagonalBlocks(source1, source2, lMinBlockSize, context);
+    }
+
+    void Process(
+        const SourceFile& source1,
+        const SourceFile& source2,
+        const LineIndex& index1,
+        const Options& options,
+        ThreadContext &context) {
+
+        size_t m = source1.GetNumOfLines();
+        size_t n = source2.GetNumOfLines();
+
         // support reporting filtering by both:
         // - "lines of code duplicated", &
         // - "percentage of file duplicated"
@@ -125,129 +451,619 @@ namespace {
                 (size_t)options.GetMinBlockSize(),
                 (std::max(n, m) * 100) / options.GetBlockPercentThreshold()));
 
-        // Scan vertical part
-        for (size_t y = 0; y < m; y++) {
-            unsigned seqLen = 0;
-            size_t maxX = std::min(n, m - y);
-            for (size_t x = 0; x < maxX; x++) {
-                if (matrix[x + n * (y + x)]) {
-                    seqLen++;
-                } else {
-                    if (seqLen >= lMinBlockSize) {
-                        unsigned line1 = y + x - seqLen;
-                        unsigned line2 = x - seqLen;
-                        if (line1 != line2 || source1 != source2) {
-                            dup_blocks.emplace_back(&source1, &source2, line1, line2, seqLen);
-                            num_dup_lines += seqLen;
-                            ++num_dup_blocks;
-                        }
-                    }
+        // Most file pairs share only a few lines, count them to decide
+        // whether filling the whole m*n matrix is worth it
+        size_t numMatches = 0;
+        for (size_t x = 0; x < n; x++) {
+            auto it = index1.find(source2.GetHash(x));
+            if (it != index1.end()) {
+                numMatches += it->second.size();
+            }
+        }
+
+        std::size_t first = context.dup_blocks.size();
+        if (numMatches * DENSE_MATCH_RATIO >= m * n) {
+            ProcessDense(source1, source2, lMinBlockSize, context);
+        } else {
+            ProcessSparse(source1, source2, index1, lMinBlockSize, context);
+        }
+
+        if (options.GetPrune()) {
+            std::size_t numBlocks = context.dup_blocks.size();
+            context.num_dup_lines -= PruneBlocks(context.dup_blocks, first);
+            context.num_dup_blocks -= numBlocks - context.dup_blocks.size();
+        }
+    }
+
+    void LogBlocksFound(IExporterPtr exporter, const SourceFile& file, std::size_t numBlocks) {
+        if (numBlocks > 0) {
+            exporter->LogMessage(std::format("{} found: {} block(s)\n", file.GetFilename(), numBlocks));
+        } else {
+            exporter->LogMessage(std::format("{} nothing found.\n", file.GetFilename()));
+        }
+    }
+
+    void ReportBlocks(
+        IExporterPtr exporter,
+        const SourceFile& file,
+        std::vector<Block>::const_iterator first,
+        std::vector<Block>::const_iterator last) {
+        std::for_each(first, last, [&exporter](Block const& block) {
+            exporter->ReportSeq(block.m_line1, block.m_line2, block.m_count, *block.m_source1, *block.m_source2);
+        });
+        LogBlocksFound(exporter, file, std::distance(first, last));
+    }
 
-                    seqLen = 0;
+    std::uint64_t EstimateCost(const SourceFile& source1, const SourceFile& source2) {
+        std::uint64_t m = source1.GetNumOfLines();
+        std::uint64_t n = source2.GetNumOfLines();
+        // hashing and indexing is linear, the comparison grows with the
+        // number of cells, of which only half are used for a file itself
+        std::uint64_t cells = &source1 == &source2 ? m * m / 2 : m * n;
+        return cells + m + n;
+    }
+
+    void FindCandidates(
+        const std::vector<SourceFile>& sourceFiles,
+        std::size_t left,
+        std::vector<bool> const& changed,
+        PostingIndex const& postingIndex,
+        Options const& options,
+        ThreadContext& context,
+        LeftFile& leftFile) {
+
+        auto const& source = sourceFiles[left];
+
+        // count the lines shared with every later file, a line that occurs
+        // a times here and b times there can be matched at most min(a, b)
+        // times; the stamps save clearing the counters for every file
+        unsigned epoch = left + 1;
+        context.touched_files.clear();
+        for (auto const& entry : postingIndex.GetEntries(left)) {
+            if (context.stop_lines->contains(entry.hash)) {
+                continue;
+            }
+            auto postings = postingIndex.Find(entry.hash);
+            auto it = std::upper_bound(postings.begin(), postings.end(), left, [](std::size_t file, PostingIndex::Posting const& posting) {
+                return file < posting.file;
+            });
+            for (; it != postings.end(); ++it) {
+                // unchanged files are only compared with changed ones
+                if (!changed[left] && !changed[it->file]) {
+                    continue;
                 }
+                if (context.shared_epochs[it->file] != epoch) {
+                    context.shared_epochs[it->file] = epoch;
+                    context.shared_lines[it->file] = 0;
+                    context.touched_files.push_back(it->file);
+                }
+                context.shared_lines[it->file] += std::min(entry.count, it->count);
+            }
+        }
+        std::sort(context.touched_files.begin(), context.touched_files.end());
+
+        // the file itself is always compared first, unless it is unchanged
+        if (changed[left]) {
+            leftFile.candidates.push_back(left);
+            leftFile.costs.push_back(EstimateCost(source, source));
+        }
+
+        // files to compare with are those after it that have enough
+        // matching lines for a block, the stop lines are not counted so
+        // then a single rare line is enough
+        unsigned minShared = context.stop_lines->empty() ? options.GetMinBlockSize() : 1;
+        for (auto right : context.touched_files) {
+            if (context.shared_lines[right] < minShared) {
+                continue;
             }
+            if (options.GetIgnoreSameFilename() && StringUtil::IsSameFilename(source, sourceFiles[right])) {
+                continue;
+            }
+            leftFile.candidates.push_back(right);
+            leftFile.costs.push_back(EstimateCost(source, sourceFiles[right]));
+        }
+    }
 
-            if (seqLen >= lMinBlockSize) {
-                unsigned line1 = m - seqLen;
-                unsigned line2 = n - seqLen;
-                if (line1 != line2 || source1 != source2) {
-                    dup_blocks.emplace_back(&source1, &source2, line1, line2, seqLen);
-                    num_dup_lines += seqLen;
-                    ++num_dup_blocks;
+    StopLines FindStopLines(
+        const std::vector<SourceFile>& sourceFiles,
+        PostingIndex const& postingIndex,
+        std::size_t maxFiles,
+        IExporterPtr exporter) {
+
+        auto frequent = postingIndex.FindFrequent(maxFiles);
+        std::sort(frequent.begin(), frequent.end(), [](auto const& l, auto const& r) {
+            return std::tie(r.second, l.first) < std::tie(l.second, r.first);
+        });
+
+        exporter->LogMessage(std::format("Ignoring {} line(s) found in more than {} files when choosing file pairs\n", frequent.size(), maxFiles));
+        for (auto const& [hash, numFiles] : frequent | std::views::take(TOP_N_STOP_LINES)) {
+            auto const& source = sourceFiles[postingIndex.Find(hash).front().file];
+            for (std::size_t i = 0; i < source.GetNumOfLines(); i++) {
+                if (source.GetHash(i) == hash) {
+                    exporter->LogMessage(std::format("  {} files: {}\n", numFiles, source.GetLine(i).GetLine()));
+                    break;
                 }
             }
         }
+        exporter->LogMessage("\n");
 
-        if (source1 != source2) {
-            // Scan horizontal part
-            for (size_t x = 1; x < n; x++) {
-                unsigned seqLen = 0;
-                size_t maxY = std::min(m, n - x);
-                for (size_t y = 0; y < maxY; y++) {
-                    if (matrix[x + y + n * y]) {
-                        seqLen++;
-                    } else {
-                        if (seqLen >= lMinBlockSize) {
-                            dup_blocks.emplace_back(&source1, &source2, y - seqLen, x + y - seqLen, seqLen);
-                            num_dup_lines += seqLen;
-                            ++num_dup_blocks;
-                        }
-                        seqLen = 0;
-                    }
+        StopLines stopLines;
+        for (auto const& [hash, numFiles] : frequent) {
+            stopLines.insert(hash);
+        }
+        return stopLines;
+    }
+
+    std::vector<Chunk> SplitIntoChunks(std::vector<LeftFile>& leftFiles, unsigned numThreads) {
+        std::uint64_t totalCost = 0;
+        for (auto const& leftFile : leftFiles) {
+            for (auto cost : leftFile.costs) {
+                totalCost += cost;
+            }
+        }
+        std::uint64_t targetCost = std::max<std::uint64_t>(totalCost / (std::uint64_t(numThreads) * CHUNKS_PER_THREAD), 1);
+
+        // cut the comparisons of every file into consecutive ranges of
+        // roughly the target cost, a single pair is never split
+        std::vector<Chunk> chunks;
+        for (std::size_t left = 0; left < leftFiles.size(); left++) {
+            auto& leftFile = leftFiles[left];
+            std::size_t slot = 0;
+            Chunk chunk{ left, slot, 0, 0, 0 };
+            for (std::size_t k = 0; k < leftFile.candidates.size(); k++) {
+                chunk.cost += leftFile.costs[k];
+                chunk.last = k + 1;
+                if (chunk.cost >= targetCost || chunk.last == leftFile.candidates.size()) {
+                    chunks.push_back(chunk);
+                    chunk = { left, ++slot, chunk.last, chunk.last, 0 };
+                }
+            }
+            leftFile.pending = slot;
+        }
+
+        // the most expensive work first, so that no large chunk is left for the end
+        std::stable_sort(chunks.begin(), chunks.end(), [](Chunk const& l, Chunk const& r) {
+            return l.cost > r.cost;
+        });
+
+        return chunks;
+    }
+
+    void ProcessChunk(
+        const std::vector<SourceFile>& sourceFiles,
+        const Chunk& chunk,
+        std::vector<LeftFile>& leftFiles,
+        Options const& options,
+        ThreadContext& context) {
+
+        auto& leftFile = leftFiles[chunk.left];
+        auto const& source = sourceFiles[chunk.left];
+
+        // positions of every line of the file, shared by all its chunks
+        std::call_once(leftFile.index_flag, [&leftFile, &source]{
+            leftFile.index = BuildLineIndex(source);
+        });
+
+        // blocks stay in the buffer of this thread until all chunks are done
+        std::size_t first = context.dup_blocks.size();
+        for (std::size_t k = chunk.first; k < chunk.last; k++) {
+            Process(source, sourceFiles[leftFile.candidates[k]], leftFile.index, options, context);
+        }
+        if (context.dup_blocks.size() > first) {
+            context.ranges.push_back({ chunk.left, chunk.slot, first, context.dup_blocks.size() });
+        }
+
+        // the last chunk of a file, the index is not needed anymore
+        if (leftFile.pending.fetch_sub(1) == 1) {
+            leftFile.index = LineIndex();
+        }
+    }
+
+    void ReportMerged(
+        const std::vector<SourceFile>& sourceFiles,
+        const std::vector<LeftFile>& leftFiles,
+        std::vector<ThreadContext*>& contexts,
+        IExporterPtr exporter) {
+
+        // every thread processed its chunks in cost order, put them back in
+        // file order and merge the threads, a chunk exists in one thread only
+        std::priority_queue<MergeHead, std::vector<MergeHead>, std::greater<MergeHead>> heads;
+        for (std::size_t t = 0; t < contexts.size(); t++) {
+            auto& ranges = contexts[t]->ranges;
+            std::sort(ranges.begin(), ranges.end(), [](BlockRange const& l, BlockRange const& r) {
+                return std::tie(l.left, l.slot) < std::tie(r.left, r.slot);
+            });
+            if (!ranges.empty()) {
+                heads.emplace(ranges[0].left, ranges[0].slot, t, 0);
+            }
+        }
+
+        for (std::size_t left = 0; left < leftFiles.size(); left++) {
+            // unchanged files without changed files to compare with are skipped
+            if (leftFiles[left].candidates.empty()) {
+                continue;
+            }
+            std::size_t numBlocks = 0;
+            while (!heads.empty() && std::get<0>(heads.top()) == left) {
+                auto [l, slot, t, r] = heads.top();
+                heads.pop();
+
+                auto const& context = *contexts[t];
+                auto const& range = context.ranges[r];
+                for (std::size_t i = range.first; i < range.last; i++) {
+                    auto const& block = context.dup_blocks[i];
+                    exporter->ReportSeq(block.m_line1, block.m_line2, block.m_count, *block.m_source1, *block.m_source2);
                 }
+                numBlocks += range.last - range.first;
 
-                if (seqLen >= lMinBlockSize) {
-                    dup_blocks.emplace_back(&source1, &source2, m - seqLen, n - seqLen, seqLen);
-                    num_dup_lines += seqLen;
-                    ++num_dup_blocks;
+                if (r + 1 < context.ranges.size()) {
+                    heads.emplace(context.ranges[r + 1].left, context.ranges[r + 1].slot, t, r + 1);
                 }
             }
+            LogBlocksFound(exporter, sourceFiles[left], numBlocks);
         }
     }
 
-    void ProcessRange(
-        std::vector<SourceFile>::iterator l_it,
+    std::tuple<std::size_t, std::size_t> RunPairwise(
+        std::vector<SourceFile>& sourceFiles,
         std::vector<SourceFile>::iterator end_it,
-        HashToFiles const& hashToFiles,
+        std::vector<bool> const& changed,
         Options const& options,
-        IExporterPtr exporter,
-        std::mutex &exporter_mtx,
-        std::unordered_map<std::thread::id, ThreadContext>& contexts) {
+        thread_pool& pool,
+        IExporterPtr exporter) {
+
+        std::size_t count = std::distance(sourceFiles.begin(), end_it);
 
-        // get matching files
-        std::unordered_set<StringPtr> matchingFiles;
-        for (std::size_t k = 0; k < l_it->GetNumOfLines(); k++) {
-            auto hash = l_it->GetLine(k).GetHash();
-            const auto& filenames = hashToFiles.find(hash)->second;
-            matchingFiles.insert(filenames.begin(), filenames.end());
+        std::unordered_map<std::thread::id, ThreadContext> contexts;
+        // the matrix is only grown when a dense pair needs it
+        for (auto const &thread_id : pool.get_thread_ids()) {
+            auto& context = contexts[thread_id];
+            context.shared_lines.resize(count);
+            context.shared_epochs.resize(count);
         }
 
-        auto& context = contexts.find(std::this_thread::get_id())->second;
+        // when only some files changed, every block has its lines in one of
+        // them, so the other lines can be left out of the index
+        std::unordered_set<std::uint64_t> changedHashes;
+        bool allChanged = std::find(changed.begin(), changed.begin() + count, false) == changed.begin() + count;
+        if (!allChanged) {
+            for (std::size_t file = 0; file < count; file++) {
+                for (std::size_t i = 0; changed[file] && i < sourceFiles[file].GetNumOfLines(); i++) {
+                    changedHashes.insert(sourceFiles[file].GetHash(i));
+                }
+            }
+        }
 
-        // compare the file with itself
-        Process(*l_it, *l_it, options, context);
+        // files containing every line, only the compared files are indexed
+        PostingIndex postingIndex(count);
+        BS::multi_future<void> adds;
+        for (unsigned file = 0; file < count; file++) {
+            adds.push_back(pool.submit_task([file, allChanged, &sourceFiles, &postingIndex, &changedHashes]{
+                postingIndex.AddFile(file, sourceFiles[file], allChanged ? nullptr : &changedHashes);
+            }));
+        }
+        WaitForTasks(adds);
+        BS::multi_future<void> shards;
+        for (std::size_t shard = 0; shard < postingIndex.GetNumShards(); shard++) {
+            shards.push_back(pool.submit_task([shard, &postingIndex]{
+                postingIndex.BuildShard(shard);
+            }));
+        }
+        WaitForTasks(shards);
 
-        // files to compare with are those that have matching lines
-        for (auto r_it = std::next(l_it); r_it != end_it; ++r_it) {
-            if (options.GetIgnoreSameFilename() && StringUtil::IsSameFilename(*l_it, *r_it)) {
-                continue;
+        // lines that are too common to make files candidates on their own
+        StopLines stopLines;
+        if (options.GetStopLineFiles() > 0) {
+            stopLines = FindStopLines(sourceFiles, postingIndex, options.GetStopLineFiles(), exporter);
+        }
+        for (auto& [tid, context] : contexts) {
+            context.stop_lines = &stopLines;
+            context.verify = options.GetVerify();
+        }
+
+        // find the files each file is compared with, and what that costs
+        std::vector<LeftFile> leftFiles(count);
+        BS::multi_future<void> candidates;
+        for (std::size_t left = 0; left < count; left++) {
+            candidates.push_back(pool.submit_task([left, &sourceFiles, &changed, &postingIndex, &options, &contexts, &leftFiles]{
+                auto& context = contexts.find(std::this_thread::get_id())->second;
+                FindCandidates(sourceFiles, left, changed, postingIndex, options, context, leftFiles[left]);
+            }));
+        }
+        WaitForTasks(candidates);
+
+        // idle threads take the next chunk from the shared queue, so the
+        // load evens out as long as there are chunks left
+        auto chunks = SplitIntoChunks(leftFiles, options.GetNumThreads());
+        BS::multi_future<void> processing;
+        for (auto const& chunk : chunks) {
+            processing.push_back(pool.submit_task([&chunk, &sourceFiles, &leftFiles, &options, &contexts]{
+                auto& context = contexts.find(std::this_thread::get_id())->second;
+                ProcessChunk(sourceFiles, chunk, leftFiles, options, context);
+            }));
+        }
+        WaitForTasks(processing);
+
+        std::size_t tot_num_dup_blocks = 0;
+        std::size_t tot_num_dup_lines = 0;
+        std::vector<ThreadContext*> threadContexts;
+        for (auto &[tid, context] : contexts) {
+            tot_num_dup_blocks += context.num_dup_blocks;
+            tot_num_dup_lines += context.num_dup_lines;
+            threadContexts.push_back(&context);
+        }
+
+        ReportMerged(sourceFiles, leftFiles, threadContexts, exporter);
+
+        return std::tuple(tot_num_dup_blocks, tot_num_dup_lines);
+    }
+
+    std::tuple<std::size_t, std::size_t> RunSuffixArray(
+        std::vector<SourceFile>& sourceFiles,
+        std::vector<SourceFile>::iterator end_it,
+        Options const& options,
+        IExporterPtr exporter) {
+
+        auto blocks = SuffixArray::FindBlocks(sourceFiles.cbegin(), end_it, options);
+        if (options.GetVerify()) {
+            VerifyBlocks(blocks, options.GetMinBlockSize());
+        }
+        if (options.GetPrune()) {
+            PruneBlocks(blocks, 0);
+        }
+
+        // blocks are ordered by their first file
+        auto block_it = blocks.cbegin();
+        for (auto l_it = sourceFiles.cbegin(); l_it != end_it; ++l_it) {
+            auto first = block_it;
+            while (block_it != blocks.cend() && block_it->m_source1 == &*l_it) {
+                ++block_it;
             }
-            if (matchingFiles.find(&r_it->GetFilename()) == matchingFiles.end()) {
-                continue;
+            ReportBlocks(exporter, *l_it, first, block_it);
+        }
+
+        std::size_t tot_num_dup_lines = 0;
+        for (auto const& block : blocks) {
+            tot_num_dup_lines += block.m_count;
+        }
+
+        return std::tuple(blocks.size(), tot_num_dup_lines);
+    }
+
+    std::tuple<std::size_t, std::size_t> RunWindowSeeds(
+        std::vector<SourceFile>& sourceFiles,
+        std::vector<SourceFile>::iterator end_it,
+        Options const& options,
+        thread_pool& pool,
+        IExporterPtr exporter) {
+
+        WindowIndex index(sourceFiles.cbegin(), end_it, options.GetMinBlockSize());
+
+        // every file gets its own slot, so they can be reported in order
+        std::vector<std::vector<Block>> blocks(std::distance(sourceFiles.begin(), end_it));
+        BS::multi_future<void> finds;
+        for (std::size_t i = 0; i < blocks.size(); i++) {
+            finds.push_back(pool.submit_task([i, &sourceFiles, &index, &options, &blocks]{
+                blocks[i] = index.FindBlocks(std::next(sourceFiles.cbegin(), i), options);
+                if (options.GetVerify()) {
+                    VerifyBlocks(blocks[i], options.GetMinBlockSize());
+                }
+                if (options.GetPrune()) {
+                    PruneBlocks(blocks[i], 0);
+                }
+            }));
+        }
+        WaitForTasks(finds);
+
+        std::size_t tot_num_dup_blocks = 0;
+        std::size_t tot_num_dup_lines = 0;
+        for (std::size_t i = 0; i < blocks.size(); i++) {
+            ReportBlocks(exporter, sourceFiles[i], blocks[i].cbegin(), blocks[i].cend());
+            tot_num_dup_blocks += blocks[i].size();
+            for (auto const& block : blocks[i]) {
+                tot_num_dup_lines += block.m_count;
             }
-            // compare the file with another file
-            Process(*l_it, *r_it, options, context);
         }
 
-        {
-            std::scoped_lock sl(exporter_mtx);
-            if (!context.dup_blocks.empty()) {
-                std::ranges::for_each(context.dup_blocks, [&exporter](Block const& block) {
-                    exporter->ReportSeq(block.m_line1, block.m_line2, block.m_count, *block.m_source1, *block.m_source2);
-                });
-                exporter->LogMessage(std::format("{} found: {} block(s)\n", l_it->GetFilename(), context.dup_blocks.size()));
-                context.dup_blocks.clear();
-            } else {
-                exporter->LogMessage(std::format("{} nothing found.\n", l_it->GetFilename()));
+        return std::tuple(tot_num_dup_blocks, tot_num_dup_lines);
+    }
+
+    void CompareWithEarlier(
+        LaterFile& later,
+        std::deque<LaterFile>& laterFiles,
+        Options const& options,
+        IExporterPtr exporter,
+        std::mutex& report_mtx,
+        std::size_t& next_report,
+        ThreadContext& context) {
+
+        auto const& source = *later.source;
+        auto index = BuildLineIndex(source);
+
+        // the later file is the left one, blocks are found the same way
+        Process(source, source, index, options, context);
+        for (auto earlier : later.earlier) {
+            Process(source, *earlier, index, options, context);
+        }
+        later.blocks = std::move(context.dup_blocks);
+        context.dup_blocks.clear();
+
+        // files are reported in list order as soon as all before them are done
+        std::scoped_lock sl(report_mtx);
+        later.done = true;
+        while (next_report < laterFiles.size() && laterFiles[next_report].done) {
+            auto& ready = laterFiles[next_report];
+            ReportBlocks(exporter, *ready.source, ready.blocks.cbegin(), ready.blocks.cend());
+            ready.blocks = {};
+            next_report++;
+        }
+    }
+
+    std::tuple<unsigned, unsigned long, std::size_t, std::size_t> RunPipelined(
+        Options const& options,
+        const FingerprintCache* cache,
+        thread_pool& pool,
+        IExporterPtr exporter) {
+
+        exporter->LogMessage("comparing while loading.\n\n");
+
+        StopLines noStopLines;
+        std::unordered_map<std::thread::id, ThreadContext> contexts;
+        for (auto const &thread_id : pool.get_thread_ids()) {
+            contexts[thread_id].stop_lines = &noStopLines;
+            contexts[thread_id].verify = options.GetVerify();
+        }
+
+        // references into deques stay valid while files are added
+        std::deque<SourceFile> sourceFiles;
+        std::deque<LaterFile> laterFiles;
+        std::mutex report_mtx;
+        std::size_t next_report = 0;
+
+        IncrementalIndex index;
+        std::vector<unsigned> sharedLines;
+        std::vector<unsigned> sharedEpochs;
+        std::vector<unsigned> touchedFiles;
+        unsigned files = 0;
+        unsigned long locsTotal = 0;
+        BS::multi_future<void> comparing;
+
+        // called in list order for every loaded file
+        auto addFile = [&](SourceFile&& loaded) {
+            if (loaded.GetNumOfLines() == 0) {
+                return;
+            }
+            files++;
+            locsTotal += loaded.GetNumOfLines();
+            unsigned file = sourceFiles.size();
+            auto const& source = sourceFiles.emplace_back(std::move(loaded));
+            if (options.GetFilesToCheck() > 0 && file >= options.GetFilesToCheck()) {
+                return;
+            }
+
+            // distinct lines of the file with their number of lines
+            std::vector<std::uint64_t> hashes(source.GetNumOfLines());
+            for (std::size_t i = 0; i < hashes.size(); i++) {
+                hashes[i] = source.GetHash(i);
             }
+            std::sort(hashes.begin(), hashes.end());
+
+            // earlier files that share enough lines for a block, counted like
+            // the pairwise candidates
+            sharedLines.resize(file + 1);
+            sharedEpochs.resize(file + 1);
+            touchedFiles.clear();
+            for (std::size_t i = 0; i < hashes.size();) {
+                auto hash = hashes[i];
+                unsigned count = 0;
+                for (; i < hashes.size() && hashes[i] == hash; i++) {
+                    count++;
+                }
+                auto& postings = index[hash];
+                for (auto const& posting : postings) {
+                    if (sharedEpochs[posting.file] != file + 1) {
+                        sharedEpochs[posting.file] = file + 1;
+                        sharedLines[posting.file] = 0;
+                        touchedFiles.push_back(posting.file);
+                    }
+                    sharedLines[posting.file] += std::min(count, posting.count);
+                }
+                postings.push_back({ file, count });
+            }
+            std::sort(touchedFiles.begin(), touchedFiles.end());
+
+            LaterFile* later;
+            {
+                std::scoped_lock sl(report_mtx);
+                later = &laterFiles.emplace_back(LaterFile{ &source, {}, {}, false });
+            }
+            for (auto earlier : touchedFiles) {
+                if (sharedLines[earlier] < options.GetMinBlockSize()) {
+                    continue;
+                }
+                if (options.GetIgnoreSameFilename() && StringUtil::IsSameFilename(source, sourceFiles[earlier])) {
+                    continue;
+                }
+                later->earlier.push_back(&sourceFiles[earlier]);
+            }
+
+            comparing.push_back(pool.submit_task([later, &laterFiles, &options, &exporter, &report_mtx, &next_report, &contexts]{
+                auto& context = contexts.find(std::this_thread::get_id())->second;
+                CompareWithEarlier(*later, laterFiles, options, exporter, report_mtx, next_report, context);
+            }));
+        };
+
+        // a few files are loaded ahead of the one that is indexed next
+        std::deque<std::future<std::optional<SourceFile>>> loading;
+        std::size_t maxLoading = 2 * std::size_t(options.GetNumThreads());
+        try {
+            FileSystem::ForEachListedFile(options.GetListFilename(), [&](const std::string& filename) {
+                if (filename.size() <= 5) {
+                    return;
+                }
+                loading.push_back(pool.submit_task([filename, &options, cache]{
+                    return std::optional<SourceFile>(std::in_place, filename, options.GetMinChars(), options.GetIgnorePrepStuff(), cache);
+                }));
+                while (loading.size() > maxLoading) {
+                    addFile(*loading.front().get());
+                    loading.pop_front();
+                }
+            });
+            while (!loading.empty()) {
+                addFile(*loading.front().get());
+                loading.pop_front();
+            }
+        }
+        catch (...) {
+            // the tasks still refer to the files
+            pool.wait();
+            throw;
+        }
+        WaitForTasks(comparing);
+
+        std::size_t tot_num_dup_blocks = 0;
+        std::size_t tot_num_dup_lines = 0;
+        for (auto const &[tid, context] : contexts) {
+            tot_num_dup_blocks += context.num_dup_blocks;
+            tot_num_dup_lines += context.num_dup_lines;
         }
+
+        return std::tuple(files, locsTotal, tot_num_dup_blocks, tot_num_dup_lines);
     }
 }
 
 int Duplo::Run(const Options& options) {
 
     IExporterPtr exporter = IExporter::CreateExporter(options);
-    std::mutex exporter_mtx;
     exporter->LogMessage("Loading and hashing files ... ");
 
     exporter->WriteHeader();
 
+    thread_pool pool(options.GetNumThreads());
+
+    std::unique_ptr<FingerprintCache> cache;
+    if (!options.GetCacheDirectory().empty()) {
+        cache = std::make_unique<FingerprintCache>(options.GetCacheDirectory(), options.GetMinChars(), options.GetIgnorePrepStuff());
+    }
+
+    if (options.GetPipelined()) {
+        auto [files, locsTotal, tot_num_dup_blocks, tot_num_dup_lines] = RunPipelined(options, cache.get(), pool, exporter);
+        exporter->WriteFooter(options, files, locsTotal, tot_num_dup_blocks, tot_num_dup_lines);
+        return tot_num_dup_blocks == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     auto lines = FileSystem::LoadFileList(options.GetListFilename());
-    auto [sourceFiles, files, locsTotal, max_lines] = LoadSourceFiles(
+    std::unordered_set<std::string> changedFiles;
+    if (!options.GetChangedListFilename().empty()) {
+        changedFiles = AddChangedFiles(lines, options.GetChangedListFilename());
+    }
+
+    auto [sourceFiles, files, locsTotal] = LoadSourceFiles(
         lines,
         options.GetMinChars(),
         options.GetIgnorePrepStuff(),
-        options.GetNumThreads(),
+        cache.get(),
+        pool,
         exporter);
 
     auto end_it = sourceFiles.end();
@@ -255,44 +1071,25 @@ int Duplo::Run(const Options& options) {
         end_it = std::next(sourceFiles.begin(), options.GetFilesToCheck());
     }
 
-    // hash maps
-    HashToFiles hashToFiles;
-    for (const auto& s : sourceFiles) {
-        for (size_t i = 0; i < s.GetNumOfLines(); i++) {
-            hashToFiles[s.GetLine(i).GetHash()].push_back(&s.GetFilename());
+    std::vector<bool> changed(sourceFiles.size(), true);
+    if (!options.GetChangedListFilename().empty()) {
+        for (std::size_t i = 0; i < sourceFiles.size(); i++) {
+            changed[i] = changedFiles.contains(NormalizePath(sourceFiles[i].GetFilename()));
         }
     }
 
-    thread_pool pool(options.GetNumThreads());
-    std::unordered_map<std::thread::id, ThreadContext> contexts;
-    // Generate matrix large enough for all files
-    try {
-        for (auto const &thread_id : pool.get_thread_ids()) {
-            contexts[thread_id] = {std::vector<bool>(max_lines * max_lines), {}, {}, {}};
-        }
-    }
-    catch (const std::bad_alloc& ex) {
-        std::ostringstream stream;
-        stream << ex.what() << '\n'
-               << "Try reducing the number of threads or exclude some the following longest files:\n"
-               << "Longest files:\n";
-        printLongestFiles(stream, sourceFiles, TOP_N_LONGEST);
-        throw std::runtime_error(stream.str().c_str());
-    }
-
-    // add a task in the threadpool to compare each file with all files after it
-    for (auto l_it = sourceFiles.begin(), l_end = end_it; l_it != l_end; ++l_it) {
-        pool.detach_task([l_it, end_it, &hashToFiles, &options, &exporter, &exporter_mtx, &contexts]{
-            ProcessRange(l_it, end_it, hashToFiles, options, exporter, exporter_mtx, contexts);
-        });
-    }
-    pool.wait();
-
     std::size_t tot_num_dup_blocks = 0;
     std::size_t tot_num_dup_lines = 0;
-    for (auto const &[tid, context] : contexts) {
-        tot_num_dup_blocks += context.num_dup_blocks;
-        tot_num_dup_lines += context.num_dup_lines;
+    switch (options.GetEngine()) {
+    case Engine::SuffixArray:
+        std::tie(tot_num_dup_blocks, tot_num_dup_lines) = RunSuffixArray(sourceFiles, end_it, options, exporter);
+        break;
+    case Engine::WindowSeeds:
+        std::tie(tot_num_dup_blocks, tot_num_dup_lines) = RunWindowSeeds(sourceFiles, end_it, options, pool, exporter);
+        break;
+    default:
+        std::tie(tot_num_dup_blocks, tot_num_dup_lines) = RunPairwise(sourceFiles, end_it, changed, options, pool, exporter);
+        break;
     }
 
     exporter->WriteFooter(options, files, locsTotal, tot_num_dup_blocks, tot_num_dup_lines);
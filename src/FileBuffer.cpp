@@ -0,0 +1,67 @@
+#include "FileBuffer.h"
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#if !defined(_WIN32)
+#define DUPLO_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+FileBuffer::FileBuffer(const std::string& filename)
+    : m_mapping(nullptr),
+      m_size(0) {
+#ifdef DUPLO_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            void* mapping = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                ::madvise(mapping, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+                m_mapping = mapping;
+                m_size = static_cast<std::size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+    }
+    if (m_mapping) {
+        return;
+    }
+#endif
+    // empty and special files, or no mmap
+    ReadAll(filename);
+}
+
+FileBuffer::~FileBuffer() {
+#ifdef DUPLO_MMAP
+    if (m_mapping) {
+        ::munmap(m_mapping, m_size);
+    }
+#endif
+}
+
+void FileBuffer::ReadAll(const std::string& filename) {
+    std::ifstream inFile(filename.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+    if (!inFile) {
+        std::ostringstream stream;
+        stream << "Error: Can't open file: " << filename << ". File doesn't exist or access denied.\n";
+        throw std::runtime_error(stream.str().c_str());
+    }
+
+    std::streampos len = inFile.tellg();
+    inFile.seekg(0);
+    m_contents.resize(static_cast<std::size_t>(len));
+    inFile.read(&m_contents[0], len);
+}
+
+std::string_view FileBuffer::GetData() const {
+    if (m_mapping) {
+        return std::string_view(static_cast<const char*>(m_mapping), m_size);
+    }
+    return m_contents;
+}
@@ -19,8 +19,6 @@ FileExporter::FileExporter(const Options& options, bool verbose) {
         logbuf = std::cout.rdbuf();
     }
 
-    m_out = std::make_shared<std::ostream>(buf);
-    m_log = std::make_shared<std::ostream>(logbuf);
     std::ostream out(buf);
     std::ostream log(logbuf);
     if (!out) {
@@ -31,6 +29,10 @@ FileExporter::FileExporter(const Options& options, bool verbose) {
             << std::endl;
         throw std::runtime_error(stream.str().c_str());
     }
+
+    m_sink = std::make_unique<AsyncOutputBuffer>(buf);
+    m_out = std::make_shared<std::ostream>(m_sink.get());
+    m_log = std::make_shared<std::ostream>(logbuf == buf ? m_sink.get() : logbuf);
 }
 
 std::ostream& FileExporter::Log() const {
@@ -5,17 +5,23 @@
 #include <iostream>
 
 std::vector<std::string> FileSystem::LoadFileList(const std::string& listFilename) {
+  std::vector<std::string> lines;
+  ForEachListedFile(listFilename, [&lines](const std::string& line) {
+      lines.push_back(line);
+  });
+  return lines;
+}
+
+void FileSystem::ForEachListedFile(const std::string& listFilename, const std::function<void(const std::string&)>& f) {
   if (listFilename == "-") {
-      std::vector<std::string> lines;
       std::string line;
       while (std::getline(std::cin, line)) {
-          lines.push_back(line);
+          f(line);
       }
-
-      return lines;
   } else {
       TextFile textFile(listFilename);
-      auto lines = textFile.ReadLines(true);
-      return lines;
+      for (auto const& line : textFile.ReadLines(true)) {
+          f(line);
+      }
   }
 }
@@ -10,8 +10,10 @@ FileTypeBase::FileTypeBase(bool ignorePrepStuff, unsigned minChars)
       m_minChars(minChars) {
 }
 
-bool FileTypeBase::IsSourceLine(const std::string& line) const {
-    std::string tmp = StringUtil::ToLower(StringUtil::Trim(line));
+bool FileTypeBase::IsSourceLine(std::string_view line) const {
+    // the markers of IsPreprocessorDirective are found ignoring case, the
+    // line is not copied
+    auto tmp = StringUtil::Trim(line);
 
     // filter min size lines
     if (tmp.size() < m_minChars) {
@@ -31,15 +33,21 @@ bool FileTypeBase::IsSourceLine(const std::string& line) const {
     return isSourceLine;
 }
 
-std::vector<SourceLine> FileTypeBase::GetCleanedSourceLines(const std::vector<std::string>& lines) const {
-    auto lineFilter = CreateLineFilter();
-    std::vector<SourceLine> filteredLines;
-    for (std::vector<std::string>::size_type i = 0; i < lines.size(); i++) {
-        auto filteredLine = GetCleanLine(lineFilter->ProcessSourceLine(lines[i]));
-        if (IsSourceLine(filteredLine)) {
-            filteredLines.emplace_back(filteredLine, static_cast<int>(i));
+void FileTypeBase::ForEachCleanedSourceLine(
+    std::string_view text,
+    const std::function<void(std::string_view, int)>& f,
+    std::pmr::memory_resource* resource) const {
+    // lines split by a comment are put together here, it keeps its capacity
+    std::pmr::string buffer(resource);
+    GetLexer().ForEachLine(text, buffer, [this, &f](std::string_view line, int index) {
+        if (IsSourceLine(line)) {
+            f(line, index);
         }
-    }
+    });
+}
 
-    return filteredLines;
+void FileTypeBase::GetCleanedSourceLines(std::string_view text, std::pmr::vector<SourceLine>& lines) const {
+    ForEachCleanedSourceLine(text, [&lines](std::string_view line, int index) {
+        lines.emplace_back(line, index);
+    }, lines.get_allocator().resource());
 }
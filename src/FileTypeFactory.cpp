@@ -8,25 +8,72 @@
 #include "FileType_VB.h"
 #include "Utils.h"
 
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace {
+    enum class Language {
+        C,
+        CS,
+        S,
+        VB,
+        Ada,
+        Java,
+        Unknown
+    };
+
+    Language GetLanguage(const std::string& filename) {
+        auto ext = StringUtil::ToLower(StringUtil::GetFileExtension(filename));
+        if (ext == "c" || ext == "cpp" || ext == "cxx" || ext == "h" || ext == "cc" || ext == "hh")
+            return Language::C;
+        else if (ext == "cs")
+            return Language::CS;
+        else if (ext == "s")
+            return Language::S;
+        else if (ext == "vb")
+            return Language::VB;
+        else if (ext == "ads" || ext == "adb")
+            return Language::Ada;
+        else if (ext == "java")
+            return Language::Java;
+        else
+            return Language::Unknown;
+    }
+
+    IFileTypePtr Create(Language language, bool ignorePrepStuff, unsigned minChars) {
+        switch (language) {
+        case Language::C:
+            return std::make_shared<FileType_C>(ignorePrepStuff, minChars);
+        case Language::CS:
+            return std::make_shared<FileType_CS>(ignorePrepStuff, minChars);
+        case Language::S:
+            return std::make_shared<FileType_S>(ignorePrepStuff, minChars);
+        case Language::VB:
+            return std::make_shared<FileType_VB>(ignorePrepStuff, minChars);
+        case Language::Ada:
+            return std::make_shared<FileType_Ada>(ignorePrepStuff, minChars);
+        case Language::Java:
+            return std::make_shared<FileType_Java>(ignorePrepStuff, minChars);
+        default:
+            return std::make_shared<FileType_Unknown>(minChars);
+        }
+    }
+}
+
 IFileTypePtr FileTypeFactory::CreateFileType(
     const std::string& filename,
     bool ignorePrepStuff,
     unsigned minChars) {
-    auto ext = StringUtil::ToLower(StringUtil::GetFileExtension(filename));
-    IFileTypePtr fileType;
-    if (ext == "c" || ext == "cpp" || ext == "cxx" || ext == "h" || ext == "cc" || ext == "hh")
-        fileType.reset(new FileType_C(ignorePrepStuff, minChars));
-    else if (ext == "cs")
-        fileType.reset(new FileType_CS(ignorePrepStuff, minChars));
-    else if (ext == "s")
-        fileType.reset(new FileType_S(ignorePrepStuff, minChars));
-    else if (ext == "vb")
-        fileType.reset(new FileType_VB(ignorePrepStuff, minChars));
-    else if (ext == "ads" || ext == "adb")
-        fileType.reset(new FileType_Ada(ignorePrepStuff, minChars));
-    else if (ext == "java")
-        fileType.reset(new FileType_Java(ignorePrepStuff, minChars));
-    else
-        fileType.reset(new FileType_Unknown(minChars));
+    // file types keep no state, so all files of a language share one
+    static std::mutex mutex;
+    static std::map<std::tuple<Language, bool, unsigned>, IFileTypePtr> fileTypes;
+
+    auto language = GetLanguage(filename);
+    std::scoped_lock lock(mutex);
+    auto& fileType = fileTypes[std::tuple(language, ignorePrepStuff, minChars)];
+    if (!fileType) {
+        fileType = Create(language, ignorePrepStuff, minChars);
+    }
     return fileType;
 }
@@ -1,22 +1,15 @@
 #include "FileType_Ada.h"
-#include "NoopLineFilter.h"
-
-#include <cstring>
+#include "Utils.h"
 
 FileType_Ada::FileType_Ada(bool ignorePrepStuff, unsigned minChars)
     : FileTypeBase(ignorePrepStuff, minChars) {
 }
 
-ILineFilterPtr FileType_Ada::CreateLineFilter() const {
-    return std::make_shared<NoopLineFilter>();
-}
-
-std::string FileType_Ada::GetCleanLine(const std::string& line) const {
-    std::string cleanedLine(line.substr(0, line.find("--")));
-    return cleanedLine;
+const SourceLexer& FileType_Ada::GetLexer() const {
+    return SourceLexer::Ada();
 }
 
-bool FileType_Ada::IsPreprocessorDirective(const std::string& line) const {
+bool FileType_Ada::IsPreprocessorDirective(std::string_view line) const {
     // look for other markers to avoid
     const char* markers[] = { "pragma", "with", "use" };
 
@@ -25,7 +18,7 @@ bool FileType_Ada::IsPreprocessorDirective(const std::string& line) const {
 	    first = 0;
 
     for (auto v : markers) {
-        if (line.find(v, first, std::strlen(v)) != std::string::npos)
+        if (StringUtil::FindNoCase(line, v, first) != std::string_view::npos)
             return true;
     }
 
@@ -1,19 +1,13 @@
 #include "FileType_C.h"
-#include "CstyleCommentsFilter.h"
-#include "Utils.h"
 
 FileType_C::FileType_C(bool ignorePrepStuff, unsigned minChars)
     : FileTypeBase(ignorePrepStuff, minChars) {
 }
 
-ILineFilterPtr FileType_C::CreateLineFilter() const {
-    return std::make_shared<CstyleCommentsLineFilter>();
+const SourceLexer& FileType_C::GetLexer() const {
+    return SourceLexer::CStyle();
 }
 
-std::string FileType_C::GetCleanLine(const std::string& line) const {
-    return CstyleUtils::RemoveSingleLineComments(line);
-}
-
-bool FileType_C::IsPreprocessorDirective(const std::string& line) const {
-    return line[0] == '#';
+bool FileType_C::IsPreprocessorDirective(std::string_view line) const {
+    return line.starts_with('#');
 }
@@ -1,27 +1,20 @@
 #include "FileType_CS.h"
-#include "CstyleCommentsFilter.h"
 #include "Utils.h"
 
-#include <cstring>
-
 FileType_CS::FileType_CS(bool ignorePrepStuff, unsigned minChars)
     : FileTypeBase(ignorePrepStuff, minChars) {
 }
 
-ILineFilterPtr FileType_CS::CreateLineFilter() const {
-    return std::make_shared<CstyleCommentsLineFilter>();
-}
-
-std::string FileType_CS::GetCleanLine(const std::string& line) const {
-    return CstyleUtils::RemoveSingleLineComments(line);
+const SourceLexer& FileType_CS::GetLexer() const {
+    return SourceLexer::CStyle();
 }
 
-bool FileType_CS::IsPreprocessorDirective(const std::string& line) const {
-    if (line[0] == '#')
+bool FileType_CS::IsPreprocessorDirective(std::string_view line) const {
+    if (line.starts_with('#'))
         return true;
 
     // look for attribute
-    if (line[0] == '[') {
+    if (line.starts_with('[')) {
         return true;
     }
 
@@ -29,7 +22,7 @@ bool FileType_CS::IsPreprocessorDirective(const std::string& line) const {
     const char* markers[] = { "using", "private", "protected", "public" };
 
     for (auto v : markers) {
-        if (line.find(v, 0, std::strlen(v)) != std::string::npos)
+        if (StringUtil::FindNoCase(line, v) != std::string_view::npos)
             return true;
     }
 
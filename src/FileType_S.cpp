@@ -1,27 +1,20 @@
 #include "FileType_S.h"
-#include "NoopLineFilter.h"
-
-#include <cstring>
+#include "Utils.h"
 
 FileType_S::FileType_S(bool ignorePrepStuff, unsigned minChars)
     : FileTypeBase(ignorePrepStuff, minChars) {
 }
 
-ILineFilterPtr FileType_S::CreateLineFilter() const {
-    return std::make_shared<NoopLineFilter>();
-}
-
-std::string FileType_S::GetCleanLine(const std::string& line) const {
-    std::string cleanedLine(line.substr(0, line.find_first_of(';')));
-    return cleanedLine;
+const SourceLexer& FileType_S::GetLexer() const {
+    return SourceLexer::Assembler();
 }
 
-bool FileType_S::IsPreprocessorDirective(const std::string& line) const {
+bool FileType_S::IsPreprocessorDirective(std::string_view line) const {
     // we can't deduplicate ret AFAIK
     const char* markers[] = { "ret" };
 
     for (auto v : markers) {
-        if (line.find(v, 0, std::strlen(v)) != std::string::npos)
+        if (StringUtil::FindNoCase(line, v) != std::string_view::npos)
             return true;
     }
 
@@ -1,18 +1,13 @@
 #include "FileType_Unknown.h"
-#include "NoopLineFilter.h"
 
 FileType_Unknown::FileType_Unknown(unsigned minChars)
     : FileTypeBase(false, minChars) {
 }
 
-ILineFilterPtr FileType_Unknown::CreateLineFilter() const {
-    return std::make_shared<NoopLineFilter>();
+const SourceLexer& FileType_Unknown::GetLexer() const {
+    return SourceLexer::Plain();
 }
 
-std::string FileType_Unknown::GetCleanLine(const std::string& line) const {
-    return line;
-}
-
-bool FileType_Unknown::IsPreprocessorDirective(const std::string&) const {
+bool FileType_Unknown::IsPreprocessorDirective(std::string_view) const {
     return false;
 }
@@ -0,0 +1,168 @@
+#include "FingerprintCache.h"
+#include "FileBuffer.h"
+#include "HashUtil.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    // bump when the layout, the hashing or the cleaning of lines changes
+    constexpr std::uint32_t CACHE_VERSION = 3;
+    constexpr char CACHE_MAGIC[8] = { 'D', 'U', 'P', 'L', 'O', 'F', 'P', '\0' };
+
+    struct EntryHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t minChars;
+        std::uint32_t ignorePrepStuff;
+        std::uint32_t pathLength;
+        std::uint64_t size;
+        std::int64_t modified;
+        std::uint64_t numLines;
+    };
+
+    // the path is padded, so that the hashes start on 8 bytes
+    std::size_t PaddedLength(std::size_t length) {
+        return (length + 7) & ~std::size_t(7);
+    }
+}
+
+FingerprintCache::FingerprintCache(const std::string& directory, unsigned minChars, bool ignorePrepStuff)
+    : m_directory(directory),
+      m_minChars(minChars),
+      m_ignorePrepStuff(ignorePrepStuff) {
+    std::error_code ec;
+    std::filesystem::create_directories(m_directory, ec);
+    if (!std::filesystem::is_directory(m_directory, ec)) {
+        throw std::runtime_error("Error: Can't create cache directory: " + m_directory);
+    }
+}
+
+std::string FingerprintCache::GetEntryFilename(const std::string& filename) const {
+    std::ostringstream key;
+    key << filename << '\n' << m_minChars << '\n' << m_ignorePrepStuff;
+    auto hash = HashUtil::Hash(key.str().c_str(), key.str().size());
+
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << hash << ".fp";
+    return (std::filesystem::path(m_directory) / name.str()).string();
+}
+
+FingerprintCache::Stamp FingerprintCache::GetStamp(const std::string& filename) {
+    std::error_code ec;
+    auto size = std::filesystem::file_size(filename, ec);
+    if (ec) {
+        return { false, 0, 0 };
+    }
+    auto modified = std::filesystem::last_write_time(filename, ec);
+    if (ec) {
+        return { false, 0, 0 };
+    }
+    return { true, size, static_cast<std::int64_t>(modified.time_since_epoch().count()) };
+}
+
+bool FingerprintCache::Load(
+    const std::string& filename,
+    const Stamp& stamp,
+    std::vector<std::uint64_t>& hashes,
+    std::vector<int>& lineNumbers) const {
+
+    auto entryFilename = GetEntryFilename(filename);
+    if (!stamp.valid || !std::filesystem::exists(entryFilename)) {
+        return false;
+    }
+
+    try {
+        FileBuffer buffer(entryFilename);
+        auto data = buffer.GetData();
+
+        EntryHeader header;
+        if (data.size() < sizeof(header)) {
+            return false;
+        }
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0
+            || header.version != CACHE_VERSION
+            || header.minChars != m_minChars
+            || header.ignorePrepStuff != m_ignorePrepStuff
+            || header.size != stamp.size
+            || header.modified != stamp.modified
+            || data.substr(sizeof(header), header.pathLength) != filename) {
+            return false;
+        }
+
+        std::size_t offset = sizeof(header) + PaddedLength(header.pathLength);
+        std::size_t numLines = header.numLines;
+        if (data.size() != offset + numLines * (sizeof(std::uint64_t) + sizeof(std::int32_t))) {
+            return false;
+        }
+
+        hashes.resize(numLines);
+        std::memcpy(hashes.data(), data.data() + offset, numLines * sizeof(std::uint64_t));
+        offset += numLines * sizeof(std::uint64_t);
+        lineNumbers.resize(numLines);
+        for (std::size_t i = 0; i < numLines; i++) {
+            std::int32_t lineNumber;
+            std::memcpy(&lineNumber, data.data() + offset + i * sizeof(lineNumber), sizeof(lineNumber));
+            lineNumbers[i] = lineNumber;
+        }
+        return true;
+    }
+    catch (const std::exception&) {
+        // a broken entry is written again
+        return false;
+    }
+}
+
+void FingerprintCache::Store(
+    const std::string& filename,
+    const Stamp& stamp,
+    const std::vector<std::uint64_t>& hashes,
+    const std::vector<int>& lineNumbers) const {
+
+    if (!stamp.valid) {
+        return;
+    }
+
+    EntryHeader header{};
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.minChars = m_minChars;
+    header.ignorePrepStuff = m_ignorePrepStuff;
+    header.pathLength = static_cast<std::uint32_t>(filename.size());
+    header.size = stamp.size;
+    header.modified = stamp.modified;
+    header.numLines = hashes.size();
+
+    std::string data(sizeof(header) + PaddedLength(filename.size()), '\0');
+    std::memcpy(data.data(), &header, sizeof(header));
+    std::memcpy(data.data() + sizeof(header), filename.data(), filename.size());
+    data.append(reinterpret_cast<const char*>(hashes.data()), hashes.size() * sizeof(std::uint64_t));
+    for (auto lineNumber : lineNumbers) {
+        std::int32_t value = lineNumber;
+        data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    // written next to the entry and renamed, so that readers never see
+    // half an entry, also when several runs share the directory
+    auto entryFilename = GetEntryFilename(filename);
+    std::ostringstream tmpFilename;
+    tmpFilename << entryFilename << '.' << std::hex << std::random_device()() << ".tmp";
+    bool written;
+    {
+        std::ofstream out(tmpFilename.str(), std::ios::binary | std::ios::trunc);
+        written = static_cast<bool>(out.write(data.data(), data.size()));
+    }
+    std::error_code ec;
+    if (written) {
+        std::filesystem::rename(tmpFilename.str(), entryFilename, ec);
+    }
+    if (!written || ec) {
+        std::filesystem::remove(tmpFilename.str(), ec);
+    }
+}
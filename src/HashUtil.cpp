@@ -1,12 +1,13 @@
 #include "HashUtil.h"
 
-// https://softwareengineering.stackexchange.com/a/49599/30671
-unsigned long HashUtil::Hash(const char* dataToHash, unsigned long length) {
-    unsigned long int h = 2166136261UL;
-    unsigned long int i;
-
-    for (i = 0; i < length; i++)
-        h = (h ^ dataToHash[i]) * 16777619;
-
-    return h;
+std::uint64_t HashUtil::Hash(const char* dataToHash, std::size_t length) {
+    Hasher hasher;
+    std::size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        hasher.Add8(Load64(dataToHash + i));
+    }
+    for (; i < length; i++) {
+        hasher.Add(dataToHash[i]);
+    }
+    return hasher.Finish();
 }
@@ -1,19 +1,31 @@
 #include "IExporter.h"
 #include "ConsoleExporter.h"
+#include "BinaryExporter.h"
+#include "CloneClassExporter.h"
 #include "JsonExporter.h"
+#include "NdjsonExporter.h"
 #include "XmlExporter.h"
 
 IExporterPtr IExporter::CreateExporter(const Options& options) {
     IExporterPtr exporter;
+    int formats = options.GetOutputXml() + options.GetOutputJSON() + options.GetOutputNdjson() + options.GetOutputBinary();
+    if (formats > 1)
+        throw std::invalid_argument("Specify a single output format");
     if (options.GetOutputXml()) {
-        if (options.GetOutputJSON())
-            throw std::invalid_argument("Specify a single output format");
         exporter = std::make_shared<XmlExporter>(options);
     } else if (options.GetOutputJSON()) {
         exporter = std::make_shared<JsonExporter>(options);
+    } else if (options.GetOutputNdjson()) {
+        exporter = std::make_shared<NdjsonExporter>(options);
+    } else if (options.GetOutputBinary()) {
+        exporter = std::make_shared<BinaryExporter>(options);
     } else {
         exporter = std::make_shared<ConsoleExporter>(options);
     }
 
+    if (options.GetCloneClasses()) {
+        exporter = std::make_shared<CloneClassExporter>(exporter);
+    }
+
     return exporter;
 }
@@ -4,8 +4,24 @@
 
 #include <iostream>
 
+namespace {
+    void WriteLines(JsonWriter& writer, const SourceFile& source, unsigned line, unsigned count) {
+        writer.Key("Lines");
+        writer.BeginArray();
+        for (unsigned j = 0; j < count; j++) {
+            writer.String(source.GetLine(line + j).GetLine());
+        }
+        writer.EndArray();
+    }
+}
+
 JsonExporter::JsonExporter(const Options& options)
-    : FileExporter(options, false) {
+    : JsonExporter(options, true) {
+}
+
+JsonExporter::JsonExporter(const Options& options, bool pretty)
+    : FileExporter(options, false),
+      m_writer(pretty) {
 }
 
 void JsonExporter::LogMessage(const std::string& message) {
@@ -21,29 +37,82 @@ void JsonExporter::WriteFooter(
     long /*locsTotal*/,
     unsigned /*tot_dup_blocks*/,
     unsigned /*tot_dup_lines*/) {
-    Out() << m_json.dump(2, ' ', true, nlohmann::json::error_handler_t::ignore);
+    // the report is null without blocks, like the former nlohmann::json one
+    if (m_empty) {
+        m_writer.Null();
+    } else {
+        m_writer.EndArray();
+    }
+    m_writer.WriteTo(Out());
     Out() << '\n';
 }
 
+void JsonExporter::WriteSeq(
+    int line1,
+    int line2,
+    int count,
+    const SourceFile& source1,
+    const SourceFile& source2) {
+    m_writer.BeginObject();
+    m_writer.Key("EndLineNumber1");
+    m_writer.Number(source1.GetLineNumber(line1 + count - 1));
+    m_writer.Key("EndLineNumber2");
+    m_writer.Number(source2.GetLineNumber(line2 + count - 1));
+    m_writer.Key("LineCount");
+    m_writer.Number(count);
+    WriteLines(m_writer, source1, line1, count);
+    m_writer.Key("SourceFile1");
+    m_writer.String(source1.GetFilename());
+    m_writer.Key("SourceFile2");
+    m_writer.String(source2.GetFilename());
+    m_writer.Key("StartLineNumber1");
+    m_writer.Number(source1.GetLineNumber(line1));
+    m_writer.Key("StartLineNumber2");
+    m_writer.Number(source2.GetLineNumber(line2));
+    m_writer.EndObject();
+}
+
+void JsonExporter::WriteClass(const CloneClass& cloneClass) {
+    auto const& first = cloneClass.m_locations.front();
+    m_writer.BeginObject();
+    m_writer.Key("LineCount");
+    m_writer.Number(cloneClass.m_count);
+    WriteLines(m_writer, *first.m_source, first.m_line, cloneClass.m_count);
+    m_writer.Key("Locations");
+    m_writer.BeginArray();
+    for (auto const& location : cloneClass.m_locations) {
+        m_writer.BeginObject();
+        m_writer.Key("EndLineNumber");
+        m_writer.Number(location.m_source->GetLineNumber(location.m_line + cloneClass.m_count - 1));
+        m_writer.Key("SourceFile");
+        m_writer.String(location.m_source->GetFilename());
+        m_writer.Key("StartLineNumber");
+        m_writer.Number(location.m_source->GetLineNumber(location.m_line));
+        m_writer.EndObject();
+    }
+    m_writer.EndArray();
+    m_writer.EndObject();
+}
+
 void JsonExporter::ReportSeq(
     int line1,
     int line2,
     int count,
     const SourceFile& source1,
     const SourceFile& source2) {
-    int begin = line1;
-    int end = line1 + count;
-    int src_begin1 = source1.GetLine(line1).GetLineNumber();
-    int src_end1 = source1.GetLine(line1 + count - 1).GetLineNumber(); // inclusive
-    int src_begin2 = source2.GetLine(line2).GetLineNumber();
-    int src_end2 = source2.GetLine(line2 + count - 1).GetLineNumber(); // inclusive
-    m_json.emplace_back(nlohmann::json{
-        { "LineCount", end - begin },
-        { "SourceFile1", source1.GetFilename() },
-        { "StartLineNumber1", src_begin1 },
-        { "EndLineNumber1", src_end1 },
-        { "SourceFile2", source2.GetFilename() },
-        { "StartLineNumber2", src_begin2 },
-        { "EndLineNumber2", src_end2 },
-        { "Lines", source1.GetLines(begin, end) } });
+    if (m_empty) {
+        m_writer.BeginArray();
+        m_empty = false;
+    }
+    WriteSeq(line1, line2, count, source1, source2);
+    m_writer.WriteTo(Out());
+}
+
+void JsonExporter::ReportClass(const CloneClass& cloneClass) {
+    if (m_empty) {
+        m_writer.BeginArray();
+        m_empty = false;
+    }
+    WriteClass(cloneClass);
+    m_writer.WriteTo(Out());
 }
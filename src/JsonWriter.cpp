@@ -0,0 +1,221 @@
+#include "JsonWriter.h"
+
+#include <cstdint>
+
+namespace {
+    const char hexDigits[] = "0123456789abcdef";
+
+    void AppendCodeUnit(std::string& out, std::uint32_t unit) {
+        char escaped[] = {
+            '\\', 'u',
+            hexDigits[(unit >> 12) & 0xF],
+            hexDigits[(unit >> 8) & 0xF],
+            hexDigits[(unit >> 4) & 0xF],
+            hexDigits[unit & 0xF]
+        };
+        out.append(escaped, sizeof(escaped));
+    }
+
+    void AppendCodePoint(std::string& out, std::uint32_t codePoint) {
+        if (codePoint <= 0xFFFF) {
+            AppendCodeUnit(out, codePoint);
+        } else {
+            codePoint -= 0x10000;
+            AppendCodeUnit(out, 0xD800 + (codePoint >> 10));
+            AppendCodeUnit(out, 0xDC00 + (codePoint & 0x3FF));
+        }
+    }
+
+    bool IsPlain(unsigned char c) {
+        return c >= 0x20 && c < 0x7F && c != '"' && c != '\\';
+    }
+
+    // decodes the sequence starting with a byte of at least 0x80 and
+    // returns its length, or the number of bytes to drop and a code point
+    // of 0 if it is invalid
+    std::size_t DecodeUtf8(std::string_view text, std::size_t pos, std::uint32_t& codePoint) {
+        auto lead = static_cast<unsigned char>(text[pos]);
+        std::size_t length;
+        // the allowed range of the second byte excludes overlong forms,
+        // surrogates and code points beyond U+10FFFF
+        unsigned char low = 0x80;
+        unsigned char high = 0xBF;
+        if (lead >= 0xC2 && lead <= 0xDF) {
+            length = 2;
+            codePoint = lead & 0x1F;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            length = 3;
+            codePoint = lead & 0x0F;
+            if (lead == 0xE0) {
+                low = 0xA0;
+            } else if (lead == 0xED) {
+                high = 0x9F;
+            }
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            length = 4;
+            codePoint = lead & 0x07;
+            if (lead == 0xF0) {
+                low = 0x90;
+            } else if (lead == 0xF4) {
+                high = 0x8F;
+            }
+        } else {
+            codePoint = 0;
+            return 1;
+        }
+
+        for (std::size_t i = 1; i < length; i++) {
+            if (pos + i == text.size()) {
+                codePoint = 0;
+                return i;
+            }
+            auto c = static_cast<unsigned char>(text[pos + i]);
+            if (c < low || c > high) {
+                // the byte that does not fit may start the next sequence
+                codePoint = 0;
+                return i;
+            }
+            low = 0x80;
+            high = 0xBF;
+            codePoint = (codePoint << 6) | (c & 0x3F);
+        }
+        return length;
+    }
+}
+
+JsonWriter::JsonWriter(bool pretty)
+    : m_pretty(pretty) {
+}
+
+void JsonWriter::BeginValue() {
+    if (m_afterKey) {
+        m_afterKey = false;
+        return;
+    }
+    if (m_empty.empty()) {
+        return;
+    }
+    if (!m_empty.back()) {
+        m_buffer += ',';
+    }
+    m_empty.back() = false;
+    if (m_pretty) {
+        m_buffer += '\n';
+        m_buffer.append(2 * m_empty.size(), ' ');
+    }
+}
+
+void JsonWriter::Begin(char bracket) {
+    BeginValue();
+    m_buffer += bracket;
+    m_empty.push_back(true);
+}
+
+void JsonWriter::End(char bracket) {
+    bool empty = m_empty.back();
+    m_empty.pop_back();
+    if (m_pretty && !empty) {
+        m_buffer += '\n';
+        m_buffer.append(2 * m_empty.size(), ' ');
+    }
+    m_buffer += bracket;
+}
+
+void JsonWriter::BeginObject() {
+    Begin('{');
+}
+
+void JsonWriter::EndObject() {
+    End('}');
+}
+
+void JsonWriter::BeginArray() {
+    Begin('[');
+}
+
+void JsonWriter::EndArray() {
+    End(']');
+}
+
+void JsonWriter::Key(std::string_view key) {
+    BeginValue();
+    AppendString(m_buffer, key);
+    m_buffer += m_pretty ? ": " : ":";
+    m_afterKey = true;
+}
+
+void JsonWriter::Number(std::int64_t value) {
+    BeginValue();
+    m_buffer += std::to_string(value);
+}
+
+void JsonWriter::String(std::string_view text) {
+    BeginValue();
+    AppendString(m_buffer, text);
+}
+
+void JsonWriter::Null() {
+    BeginValue();
+    m_buffer += "null";
+}
+
+void JsonWriter::WriteTo(std::ostream& out) {
+    out << m_buffer;
+    m_buffer.clear();
+}
+
+void JsonWriter::AppendString(std::string& out, std::string_view text) {
+    out += '"';
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        std::size_t plain = pos;
+        while (plain < text.size() && IsPlain(static_cast<unsigned char>(text[plain]))) {
+            plain++;
+        }
+        out.append(text, pos, plain - pos);
+        pos = plain;
+        if (pos == text.size()) {
+            break;
+        }
+
+        auto c = static_cast<unsigned char>(text[pos]);
+        switch (c) {
+        case '"':
+            out += "\\\"";
+            break;
+        case '\\':
+            out += "\\\\";
+            break;
+        case '\b':
+            out += "\\b";
+            break;
+        case '\f':
+            out += "\\f";
+            break;
+        case '\n':
+            out += "\\n";
+            break;
+        case '\r':
+            out += "\\r";
+            break;
+        case '\t':
+            out += "\\t";
+            break;
+        default:
+            if (c < 0x80) {
+                AppendCodeUnit(out, c);
+            } else {
+                std::uint32_t codePoint;
+                auto length = DecodeUtf8(text, pos, codePoint);
+                if (codePoint != 0) {
+                    AppendCodePoint(out, codePoint);
+                }
+                pos += length;
+                continue;
+            }
+            break;
+        }
+        pos++;
+    }
+    out += '"';
+}
@@ -0,0 +1,185 @@
+#include "LineKernel.h"
+#include "CpuFeatures.h"
+#include "HashUtil.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#ifdef DUPLO_X86_64
+#include <immintrin.h>
+#endif
+
+namespace {
+    // chars are compared signed like in SourceLine, bytes from 0x80 up are
+    // below ' ' and skipped as well
+    inline bool IsNonBlank(char c) {
+        return c > ' ';
+    }
+
+    using Stops = std::array<char, 4>;
+
+    std::size_t FindFirstOfScalar(std::string_view text, std::size_t pos, const Stops& stops) {
+        for (; pos < text.size(); pos++) {
+            char c = text[pos];
+            if (c == stops[0] || c == stops[1] || c == stops[2] || c == stops[3]) {
+                return pos;
+            }
+        }
+        return text.size();
+    }
+
+    std::uint64_t HashNonBlankScalar(std::string_view line, HashUtil::Hasher hasher = {}) {
+        for (char c : line) {
+            if (IsNonBlank(c)) {
+                hasher.Add(c);
+            }
+        }
+        return hasher.Finish();
+    }
+
+#ifdef DUPLO_X86_64
+    // a set bit for every byte of the block that matches
+    template <typename Block, typename F>
+    void ForEachBit(const char* p, Block mask, F f) {
+        while (mask != 0) {
+            f(p + std::countr_zero(mask));
+            mask &= mask - 1;
+        }
+    }
+
+    std::size_t FindFirstOfSse2(std::string_view text, std::size_t pos, const Stops& stops) {
+        const char* data = text.data();
+        const __m128i stop0 = _mm_set1_epi8(stops[0]);
+        const __m128i stop1 = _mm_set1_epi8(stops[1]);
+        const __m128i stop2 = _mm_set1_epi8(stops[2]);
+        const __m128i stop3 = _mm_set1_epi8(stops[3]);
+        for (; pos + 16 <= text.size(); pos += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+            __m128i found = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(v, stop0), _mm_cmpeq_epi8(v, stop1)),
+                _mm_or_si128(_mm_cmpeq_epi8(v, stop2), _mm_cmpeq_epi8(v, stop3)));
+            auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(found));
+            if (mask != 0) {
+                return pos + std::countr_zero(mask);
+            }
+        }
+        return FindFirstOfScalar(text, pos, stops);
+    }
+
+    std::uint64_t HashNonBlankSse2(std::string_view line) {
+        const char* data = line.data();
+        HashUtil::Hasher hasher;
+        std::size_t i = 0;
+        const __m128i space = _mm_set1_epi8(' ');
+        for (; i + 16 <= line.size(); i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(v, space)));
+            if (mask == 0xFFFF) {
+                for (std::size_t j = 0; j < 16; j += 8) {
+                    hasher.Add8(HashUtil::Load64(data + i + j));
+                }
+            } else {
+                ForEachBit(data + i, mask, [&hasher](const char* p) {
+                    hasher.Add(*p);
+                });
+            }
+        }
+        return HashNonBlankScalar(line.substr(i), hasher);
+    }
+
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((target("avx2")))
+#endif
+    std::size_t FindFirstOfAvx2(std::string_view text, std::size_t pos, const Stops& stops) {
+        const char* data = text.data();
+        const __m256i stop0 = _mm256_set1_epi8(stops[0]);
+        const __m256i stop1 = _mm256_set1_epi8(stops[1]);
+        const __m256i stop2 = _mm256_set1_epi8(stops[2]);
+        const __m256i stop3 = _mm256_set1_epi8(stops[3]);
+        for (; pos + 32 <= text.size(); pos += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+            __m256i found = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, stop0), _mm256_cmpeq_epi8(v, stop1)),
+                _mm256_or_si256(_mm256_cmpeq_epi8(v, stop2), _mm256_cmpeq_epi8(v, stop3)));
+            auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(found));
+            if (mask != 0) {
+                return pos + std::countr_zero(mask);
+            }
+        }
+        return FindFirstOfSse2(text, pos, stops);
+    }
+
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((target("avx2")))
+#endif
+    std::uint64_t HashNonBlankAvx2(std::string_view line) {
+        const char* data = line.data();
+        HashUtil::Hasher hasher;
+        std::size_t i = 0;
+        const __m256i space = _mm256_set1_epi8(' ');
+        for (; i + 32 <= line.size(); i += 32) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(v, space)));
+            if (mask == 0xFFFFFFFF) {
+                for (std::size_t j = 0; j < 32; j += 8) {
+                    hasher.Add8(HashUtil::Load64(data + i + j));
+                }
+            } else {
+                ForEachBit(data + i, mask, [&hasher](const char* p) {
+                    hasher.Add(*p);
+                });
+            }
+        }
+        return HashNonBlankScalar(line.substr(i), hasher);
+    }
+#endif
+
+    using FindFunction = std::size_t (*)(std::string_view, std::size_t, const Stops&);
+    using HashFunction = std::uint64_t (*)(std::string_view);
+
+    FindFunction SelectFind() {
+#ifdef DUPLO_X86_64
+        return CpuFeatures::HasAvx2() ? FindFirstOfAvx2 : FindFirstOfSse2;
+#else
+        return FindFirstOfScalar;
+#endif
+    }
+
+    HashFunction SelectHash() {
+#ifdef DUPLO_X86_64
+        return CpuFeatures::HasAvx2() ? HashNonBlankAvx2 : HashNonBlankSse2;
+#else
+        return HashNonBlankScalar;
+#endif
+    }
+}
+
+std::size_t LineKernel::FindFirstOf(std::string_view text, std::size_t pos, const std::array<char, 4>& stops) {
+    static const FindFunction find = SelectFind();
+    return find(text, pos, stops);
+}
+
+std::uint64_t LineKernel::HashNonBlank(std::string_view line) {
+    static const HashFunction hash = SelectHash();
+    return hash(line);
+}
+
+bool LineKernel::EqualNonBlank(std::string_view line1, std::string_view line2) {
+    std::size_t i = 0;
+    std::size_t j = 0;
+    for (;;) {
+        while (i < line1.size() && !IsNonBlank(line1[i])) {
+            i++;
+        }
+        while (j < line2.size() && !IsNonBlank(line2[j])) {
+            j++;
+        }
+        if (i == line1.size() || j == line2.size()) {
+            return i == line1.size() && j == line2.size();
+        }
+        if (line1[i++] != line2[j++]) {
+            return false;
+        }
+    }
+}
@@ -27,7 +27,35 @@ namespace {
             bool ignorePrepStuff = ap.is("-ip");
             bool outputXml = ap.is("-xml");
             bool outputJSON = ap.is("-json");
+            bool outputNdjson = ap.is("-ndjson");
+            bool outputBinary = ap.is("-bin");
             bool ignoreSameFilename = ap.is("-d");
+            if (ap.is("-sa") && ap.is("-ws")) {
+                throw std::invalid_argument("Specify a single detection engine");
+            }
+            Engine engine = ap.is("-sa") ? Engine::SuffixArray
+                : ap.is("-ws")           ? Engine::WindowSeeds
+                                         : Engine::Pairwise;
+            auto stopLineFiles = ap.getInt("-sl", 0);
+            if (stopLineFiles > 0 && engine != Engine::Pairwise) {
+                throw std::invalid_argument("-sl only applies when comparing file pairs");
+            }
+            bool pipelined = ap.is("-p");
+            if (pipelined && (engine != Engine::Pairwise || stopLineFiles > 0)) {
+                throw std::invalid_argument("-p can't be combined with -sa, -ws or -sl");
+            }
+            std::string cacheDirectory(ap.getStr("-cache"));
+            std::string changedListFilename(ap.getStr("-changed"));
+            // changed files that are added to the list could be left out by -n
+            if (!changedListFilename.empty() && (engine != Engine::Pairwise || pipelined || numberOfFiles > 0)) {
+                throw std::invalid_argument("-changed can't be combined with -sa, -ws, -p or -n");
+            }
+            bool verify = ap.is("-verify");
+            bool prune = ap.is("-prune");
+            bool cloneClasses = ap.is("-classes");
+            if (cloneClasses && pipelined) {
+                throw std::invalid_argument("-classes can't be combined with -p");
+            }
             std::string listFilename(argv[argc - 2]);
             std::string outputFilename(argv[argc - 1]);
             Options options(
@@ -39,7 +67,17 @@ namespace {
                 numThreads,
                 outputXml,
                 outputJSON,
+                outputNdjson,
+                outputBinary,
                 ignoreSameFilename,
+                engine,
+                stopLineFiles,
+                pipelined,
+                cacheDirectory,
+                changedListFilename,
+                verify,
+                cloneClasses,
+                prune,
                 listFilename,
                 outputFilename);
             return Duplo::Run(options);
@@ -64,8 +102,33 @@ namespace {
             std::cout << "       -j               number of threads to use (default is 1)\n";
             std::cout << "       -ip              ignore preprocessor directives\n";
             std::cout << "       -d               ignore file pairs with same name\n";
+            std::cout << "       -sa              find duplicates with a suffix array over all files\n";
+            std::cout << "                        instead of comparing file pairs\n";
+            std::cout << "       -ws              only compare lines around windows of -ml lines\n";
+            std::cout << "                        that are shared by both files\n";
+            std::cout << "       -sl              ignore lines found in more than N files when\n";
+            std::cout << "                        choosing file pairs, blocks need other lines too\n";
+            std::cout << "                        (default is 0, all lines are used)\n";
+            std::cout << "       -p               compare every file with the files before it\n";
+            std::cout << "                        while loading, blocks are grouped by the\n";
+            std::cout << "                        later file\n";
+            std::cout << "       -cache           directory to keep the hashed lines of files in,\n";
+            std::cout << "                        unchanged files are not read again\n";
+            std::cout << "       -changed         file with a list of changed files, only blocks\n";
+            std::cout << "                        in one of them are reported, the other\n";
+            std::cout << "                        files are not compared with each other\n";
+            std::cout << "       -verify          compare the text of the lines of every block,\n";
+            std::cout << "                        lines that only have the same hash end it\n";
+            std::cout << "       -prune           leave out blocks that lie within a longer block\n";
+            std::cout << "                        of the same files, repeats are reported once\n";
+            std::cout << "       -classes         report the blocks with the same lines once, as\n";
+            std::cout << "                        a clone class with all of their places\n";
             std::cout << "       -xml             output file in XML\n";
             std::cout << "       -json            output file in JSON format\n";
+            std::cout << "       -ndjson          output file in JSON format, one line per block\n";
+            std::cout << "       -bin             output file in a compact binary format, the text\n";
+            std::cout << "                        of a block is only written once, duplo-report\n";
+            std::cout << "                        converts it to JSON\n";
             std::cout << "       INPUT_FILELIST   input filelist (specify '-' to read from stdin)\n";
             std::cout << "       OUTPUT_FILE      output file (specify '-' to output to stdout)\n";
 
@@ -0,0 +1,178 @@
+#include "MatchMatrix.h"
+#include "CpuFeatures.h"
+
+#include <algorithm>
+#include <bit>
+
+#ifdef DUPLO_X86_64
+#include <immintrin.h>
+#endif
+
+namespace {
+    constexpr std::size_t WORD_BITS = 64;
+
+    // 32 KiB per tile, small enough to stay in the L1/L2 cache
+    constexpr std::size_t TILE_WORDS = 4096;
+
+    std::size_t NumWords(std::size_t bits) {
+        return (bits + WORD_BITS - 1) / WORD_BITS;
+    }
+
+    void CompareScalar(const std::uint64_t* a, const std::uint64_t* b, std::size_t length, std::uint64_t* words) {
+        for (std::size_t i = 0; i < length; i += WORD_BITS) {
+            std::size_t end = std::min(length - i, WORD_BITS);
+            std::uint64_t word = 0;
+            for (std::size_t j = 0; j < end; j++) {
+                word |= static_cast<std::uint64_t>(a[i + j] == b[i + j]) << j;
+            }
+            words[i / WORD_BITS] = word;
+        }
+    }
+
+#ifdef DUPLO_X86_64
+#if defined(__GNUC__) || defined(__clang__)
+    __attribute__((target("avx2")))
+#endif
+    void CompareAvx2(const std::uint64_t* a, const std::uint64_t* b, std::size_t length, std::uint64_t* words) {
+        std::size_t full = length / WORD_BITS * WORD_BITS;
+        for (std::size_t i = 0; i < full; i += WORD_BITS) {
+            std::uint64_t word = 0;
+            for (std::size_t j = 0; j < WORD_BITS; j += 4) {
+                __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + j));
+                __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + j));
+                auto mask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(va, vb)));
+                word |= static_cast<std::uint64_t>(mask) << j;
+            }
+            words[i / WORD_BITS] = word;
+        }
+        if (full < length) {
+            CompareScalar(a + full, b + full, length - full, words + full / WORD_BITS);
+        }
+    }
+#endif
+
+    using CompareFunction = void (*)(const std::uint64_t*, const std::uint64_t*, std::size_t, std::uint64_t*);
+
+    CompareFunction SelectCompare() {
+#ifdef DUPLO_X86_64
+        if (CpuFeatures::HasAvx2()) {
+            return CompareAvx2;
+        }
+#endif
+        return CompareScalar;
+    }
+}
+
+void MatchKernel::Compare(const std::uint64_t* a, const std::uint64_t* b, std::size_t length, std::uint64_t* words) {
+    static const CompareFunction compare = SelectCompare();
+    compare(a, b, length, words);
+}
+
+void MatchMatrix::FindRuns(
+    const std::uint64_t* hashes1,
+    std::size_t m,
+    const std::uint64_t* hashes2,
+    std::size_t n,
+    bool sameFile,
+    unsigned minLength,
+    std::vector<DiagonalBlock>& runs) {
+
+    m_words.resize(TILE_WORDS);
+    m_segments.clear();
+    m_used = 0;
+    OpenRun run{ 0, 0, 0 };
+
+    auto addDiagonal = [&](unsigned diagonal, const std::uint64_t* a, const std::uint64_t* b, std::size_t length) {
+        for (std::size_t pos = 0; pos < length;) {
+            if (m_used == TILE_WORDS) {
+                ScanTile(run, minLength, runs);
+            }
+            std::size_t bits = std::min(length - pos, (TILE_WORDS - m_used) * WORD_BITS);
+            MatchKernel::Compare(a + pos, b + pos, bits, m_words.data() + m_used);
+            m_segments.push_back({ diagonal, static_cast<unsigned>(pos), static_cast<unsigned>(bits), m_used });
+            m_used += NumWords(bits);
+            pos += bits;
+        }
+    };
+
+    // lower half, line1 - line2 = d
+    for (std::size_t d = sameFile ? 1 : 0; d < m; d++) {
+        addDiagonal(d, hashes1 + d, hashes2, std::min(n, m - d));
+    }
+    // upper half, line2 - line1 = d
+    if (!sameFile) {
+        for (std::size_t d = 1; d < n; d++) {
+            addDiagonal(m + d, hashes1, hashes2 + d, std::min(m, n - d));
+        }
+    }
+
+    ScanTile(run, minLength, runs);
+    if (run.length > 0 && run.length >= minLength) {
+        runs.push_back({ run.diagonal, run.start, run.length });
+    }
+}
+
+void MatchMatrix::ScanTile(OpenRun& run, unsigned minLength, std::vector<DiagonalBlock>& runs) {
+    auto closeRun = [&]() {
+        if (run.length > 0 && run.length >= minLength) {
+            runs.push_back({ run.diagonal, run.start, run.length });
+        }
+        run.length = 0;
+    };
+
+    for (auto const& segment : m_segments) {
+        // a run can only continue from the previous segment of the same diagonal
+        if (segment.diagonal != run.diagonal) {
+            closeRun();
+            run.diagonal = segment.diagonal;
+        }
+
+        const std::uint64_t* words = m_words.data() + segment.offset;
+
+        // runs are delimited by the zero bits, skip over whole words when
+        // possible and count the ones and zeros in between otherwise
+        for (unsigned w = 0; w * WORD_BITS < segment.length; w++) {
+            unsigned base = segment.start + w * WORD_BITS;
+            unsigned bits = std::min<unsigned>(WORD_BITS, segment.length - w * WORD_BITS);
+            std::uint64_t word = words[w];
+            if (bits < WORD_BITS) {
+                word &= (std::uint64_t(1) << bits) - 1;
+            }
+
+            if (word == 0) {
+                closeRun();
+                continue;
+            }
+            if (bits == WORD_BITS && word == ~std::uint64_t(0)) {
+                if (run.length == 0) {
+                    run.start = base;
+                }
+                run.length += WORD_BITS;
+                continue;
+            }
+
+            unsigned pos = 0;
+            while (pos < bits) {
+                std::uint64_t rest = word >> pos;
+                unsigned ones = std::min<unsigned>(std::countr_one(rest), bits - pos);
+                if (ones > 0) {
+                    if (run.length == 0) {
+                        run.start = base + pos;
+                    }
+                    run.length += ones;
+                    pos += ones;
+                    if (pos >= bits) {
+                        break;
+                    }
+                }
+
+                closeRun();
+                rest = word >> pos;
+                pos += rest == 0 ? bits - pos : std::countr_zero(rest);
+            }
+        }
+    }
+
+    m_segments.clear();
+    m_used = 0;
+}
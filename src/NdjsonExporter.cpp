@@ -0,0 +1,33 @@
+#include "Block.h"
+#include "NdjsonExporter.h"
+
+#include <iostream>
+
+NdjsonExporter::NdjsonExporter(const Options& options)
+    : JsonExporter(options, false) {
+}
+
+void NdjsonExporter::WriteFooter(
+    const Options& /*options*/,
+    int /*files*/,
+    long /*locsTotal*/,
+    unsigned /*tot_dup_blocks*/,
+    unsigned /*tot_dup_lines*/) {
+}
+
+void NdjsonExporter::ReportSeq(
+    int line1,
+    int line2,
+    int count,
+    const SourceFile& source1,
+    const SourceFile& source2) {
+    WriteSeq(line1, line2, count, source1, source2);
+    m_writer.WriteTo(Out());
+    Out() << '\n';
+}
+
+void NdjsonExporter::ReportClass(const CloneClass& cloneClass) {
+    WriteClass(cloneClass);
+    m_writer.WriteTo(Out());
+    Out() << '\n';
+}
@@ -9,7 +9,17 @@ Options::Options(
     unsigned numThreads,
     bool outputXml,
     bool outputJSON,
+    bool outputNdjson,
+    bool outputBinary,
     bool ignoreSameFilename,
+    Engine engine,
+    unsigned stopLineFiles,
+    bool pipelined,
+    const std::string& cacheDirectory,
+    const std::string& changedListFilename,
+    bool verify,
+    bool cloneClasses,
+    bool prune,
     const std::string& listFilename,
     const std::string& outputFilename)
     : m_minChars(minChars)
@@ -20,7 +30,17 @@ Options::Options(
     , m_numThreads(numThreads)
     , m_outputXml(outputXml)
     , m_outputJSON(outputJSON)
+    , m_outputNdjson(outputNdjson)
+    , m_outputBinary(outputBinary)
     , m_ignoreSameFilename(ignoreSameFilename)
+    , m_engine(engine)
+    , m_stopLineFiles(stopLineFiles)
+    , m_pipelined(pipelined)
+    , m_cacheDirectory(cacheDirectory)
+    , m_changedListFilename(changedListFilename)
+    , m_verify(verify)
+    , m_cloneClasses(cloneClasses)
+    , m_prune(prune)
     , m_listFilename(listFilename)
     , m_outputFilename(outputFilename)
 {
@@ -50,10 +70,50 @@ bool Options::GetOutputJSON() const {
     return m_outputJSON;
 }
 
+bool Options::GetOutputNdjson() const {
+    return m_outputNdjson;
+}
+
+bool Options::GetOutputBinary() const {
+    return m_outputBinary;
+}
+
 bool Options::GetIgnoreSameFilename() const {
     return m_ignoreSameFilename;
 }
 
+Engine Options::GetEngine() const {
+    return m_engine;
+}
+
+unsigned Options::GetStopLineFiles() const {
+    return m_stopLineFiles;
+}
+
+bool Options::GetPipelined() const {
+    return m_pipelined;
+}
+
+const std::string& Options::GetCacheDirectory() const {
+    return m_cacheDirectory;
+}
+
+const std::string& Options::GetChangedListFilename() const {
+    return m_changedListFilename;
+}
+
+bool Options::GetVerify() const {
+    return m_verify;
+}
+
+bool Options::GetCloneClasses() const {
+    return m_cloneClasses;
+}
+
+bool Options::GetPrune() const {
+    return m_prune;
+}
+
 const std::string& Options::GetListFilename() const {
     return m_listFilename;
 }
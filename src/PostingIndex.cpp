@@ -0,0 +1,104 @@
+#include "PostingIndex.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+    constexpr unsigned SHARD_BITS = 8;
+
+    struct ShardPosting {
+        std::uint64_t hash;
+        PostingIndex::Posting posting;
+    };
+}
+
+std::size_t PostingIndex::ShardOf(std::uint64_t hash) {
+    // the multiplication mixes all bits of the hash into the top ones
+    return static_cast<std::size_t>((hash * 0x9E3779B97F4A7C15ULL) >> (64 - SHARD_BITS));
+}
+
+PostingIndex::PostingIndex(std::size_t numFiles)
+    : m_entries(numFiles)
+    , m_shards(std::size_t(1) << SHARD_BITS) {
+}
+
+std::size_t PostingIndex::GetNumShards() const {
+    return m_shards.size();
+}
+
+void PostingIndex::AddFile(unsigned file, const SourceFile& source, const std::unordered_set<std::uint64_t>* onlyHashes) {
+    std::vector<std::uint64_t> hashes;
+    hashes.reserve(source.GetNumOfLines());
+    for (std::size_t i = 0; i < source.GetNumOfLines(); i++) {
+        if (!onlyHashes || onlyHashes->contains(source.GetHash(i))) {
+            hashes.push_back(source.GetHash(i));
+        }
+    }
+    std::sort(hashes.begin(), hashes.end(), [](std::uint64_t l, std::uint64_t r) {
+        return std::make_pair(ShardOf(l), l) < std::make_pair(ShardOf(r), r);
+    });
+
+    auto& entries = m_entries[file];
+    for (auto hash : hashes) {
+        if (entries.empty() || entries.back().hash != hash) {
+            entries.push_back({ hash, 0 });
+        }
+        entries.back().count++;
+    }
+}
+
+void PostingIndex::BuildShard(std::size_t shard) {
+    // files are visited in order, so a stable sort keeps every posting list
+    // ordered by file
+    std::vector<ShardPosting> all;
+    for (unsigned file = 0; file < m_entries.size(); file++) {
+        auto const& entries = m_entries[file];
+        auto first = std::partition_point(entries.begin(), entries.end(), [shard](Entry const& entry) {
+            return ShardOf(entry.hash) < shard;
+        });
+        for (auto it = first; it != entries.end() && ShardOf(it->hash) == shard; ++it) {
+            all.push_back({ it->hash, { file, it->count } });
+        }
+    }
+    std::stable_sort(all.begin(), all.end(), [](ShardPosting const& l, ShardPosting const& r) {
+        return l.hash < r.hash;
+    });
+
+    auto& result = m_shards[shard];
+    result.postings.reserve(all.size());
+    for (auto const& p : all) {
+        if (result.hashes.empty() || result.hashes.back() != p.hash) {
+            result.hashes.push_back(p.hash);
+            result.offsets.push_back(result.postings.size());
+        }
+        result.postings.push_back(p.posting);
+    }
+    result.offsets.push_back(result.postings.size());
+}
+
+std::span<const PostingIndex::Entry> PostingIndex::GetEntries(unsigned file) const {
+    return m_entries[file];
+}
+
+std::span<const PostingIndex::Posting> PostingIndex::Find(std::uint64_t hash) const {
+    auto const& shard = m_shards[ShardOf(hash)];
+    auto it = std::lower_bound(shard.hashes.begin(), shard.hashes.end(), hash);
+    if (it == shard.hashes.end() || *it != hash) {
+        return {};
+    }
+    auto i = std::distance(shard.hashes.begin(), it);
+    return std::span<const Posting>(shard.postings).subspan(shard.offsets[i], shard.offsets[i + 1] - shard.offsets[i]);
+}
+
+std::vector<std::pair<std::uint64_t, std::size_t>> PostingIndex::FindFrequent(std::size_t maxFiles) const {
+    std::vector<std::pair<std::uint64_t, std::size_t>> frequent;
+    for (auto const& shard : m_shards) {
+        for (std::size_t i = 0; i < shard.hashes.size(); i++) {
+            std::size_t numFiles = shard.offsets[i + 1] - shard.offsets[i];
+            if (numFiles > maxFiles) {
+                frequent.emplace_back(shard.hashes[i], numFiles);
+            }
+        }
+    }
+    return frequent;
+}
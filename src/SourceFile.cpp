@@ -1,24 +1,60 @@
 #include "SourceFile.h"
+#include "FileBuffer.h"
 #include "FileTypeFactory.h"
 #include "IFileType.h"
+#include "LineKernel.h"
 #include "SourceLine.h"
-#include "TextFile.h"
+#include "Utils.h"
 
-#include <algorithm>
-#include <iterator>
+#include <stdexcept>
+#include <utility>
 #include <vector>
 
-SourceFile::SourceFile(const std::string& filename, unsigned minChars, bool ignorePrepStuff)
+namespace {
+    // pools the memory of the files loaded by a thread, every file releases
+    // its arena back to it
+    std::pmr::memory_resource* GetLoadResource() {
+        thread_local std::pmr::unsynchronized_pool_resource resource;
+        return &resource;
+    }
+}
+
+SourceFile::SourceFile(const std::string& filename, unsigned minChars, bool ignorePrepStuff, const FingerprintCache* cache)
     : m_filename(filename),
-      m_fileType(FileTypeFactory::CreateFileType(filename, ignorePrepStuff, minChars)) {
-    TextFile listOfFiles(m_filename);
+      m_fileType(FileTypeFactory::CreateFileType(filename, ignorePrepStuff, minChars)),
+      m_text(std::make_unique<Text>()) {
+    FingerprintCache::Stamp stamp{};
+    if (cache) {
+        stamp = FingerprintCache::GetStamp(m_filename);
+        if (cache->Load(m_filename, stamp, m_hashes, m_lineNumbers)) {
+            return;
+        }
+    }
+
+    // hashed straight from the cleaned lines, the text is not kept. They
+    // are gathered in an arena and copied once their number is known.
+    FileBuffer buffer(m_filename);
+    std::pmr::monotonic_buffer_resource arena(GetLoadResource());
+    std::pmr::vector<std::uint64_t> hashes(&arena);
+    std::pmr::vector<int> lineNumbers(&arena);
+    m_fileType->ForEachCleanedSourceLine(buffer.GetData(), [&](std::string_view line, int index) {
+        hashes.push_back(LineKernel::HashNonBlank(line));
+        lineNumbers.push_back(index + 1);
+    }, &arena);
+    m_hashes.assign(hashes.begin(), hashes.end());
+    m_lineNumbers.assign(lineNumbers.begin(), lineNumbers.end());
 
-    auto lines = listOfFiles.ReadLines(false);
-    m_sourceLines = m_fileType->GetCleanedSourceLines(lines);
+    if (cache) {
+        cache->Store(m_filename, stamp, m_hashes, m_lineNumbers);
+    }
 }
 
 SourceFile::SourceFile(SourceFile&& right) noexcept
-    : m_filename(std::move(right.m_filename)), m_fileType(std::move(right.m_fileType)), m_sourceLines(std::move(right.m_sourceLines)) {
+    : m_filename(std::move(right.m_filename)),
+      m_fileType(std::move(right.m_fileType)),
+      m_hashes(std::move(right.m_hashes)),
+      m_lineNumbers(std::move(right.m_lineNumbers)),
+      m_text(std::move(right.m_text)) {
 }
 
 SourceFile& SourceFile::operator=(SourceFile const& other) {
@@ -27,28 +63,44 @@ SourceFile& SourceFile::operator=(SourceFile const& other) {
     }
     m_filename = other.m_filename;
     m_fileType = other.m_fileType;
-    m_sourceLines = other.m_sourceLines;
+    m_hashes = other.m_hashes;
+    m_lineNumbers = other.m_lineNumbers;
+    m_text = std::make_unique<Text>();
     return *this;
 }
 
+const std::pmr::vector<SourceLine>& SourceFile::GetText() const {
+    std::call_once(m_text->loaded, [this]{
+        FileBuffer buffer(m_filename);
+        auto& lines = m_text->lines;
+        lines.clear();
+        lines.reserve(m_hashes.size());
+        m_fileType->GetCleanedSourceLines(buffer.GetData(), lines);
+        bool same = lines.size() == m_hashes.size();
+        for (std::size_t i = 0; same && i < lines.size(); i++) {
+            same = lines[i].GetHash() == m_hashes[i];
+        }
+        if (!same) {
+            throw std::runtime_error("Error: File changed while it was scanned: " + m_filename);
+        }
+    });
+    return m_text->lines;
+}
+
 size_t SourceFile::GetNumOfLines() const {
-    return m_sourceLines.size();
+    return m_hashes.size();
 }
 
-const SourceLine& SourceFile::GetLine(int index) const {
-    return m_sourceLines[index];
+std::uint64_t SourceFile::GetHash(int index) const {
+    return m_hashes[index];
 }
 
-std::vector<std::string> SourceFile::GetLines(int begin, int end) const {
-    std::vector<std::string> lines;
-    lines.reserve(end - begin);
-    auto begin_it = std::next(m_sourceLines.begin(), begin);
-    auto end_it = std::next(m_sourceLines.begin(), end);
-    std::transform(begin_it, end_it, std::back_inserter(lines),
-        [](SourceLine const& line) {
-            return line.GetLine();
-        });
-    return lines;
+int SourceFile::GetLineNumber(int index) const {
+    return m_lineNumbers[index];
+}
+
+const SourceLine& SourceFile::GetLine(int index) const {
+    return GetText()[index];
 }
 
 const std::string& SourceFile::GetFilename() const {
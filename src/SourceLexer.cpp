@@ -0,0 +1,209 @@
+#include "SourceLexer.h"
+#include "LineKernel.h"
+
+#include <stdexcept>
+
+namespace {
+    // the code of a line, only copied when a comment splits it in two
+    class LineParts {
+        std::string_view m_text;
+        std::pmr::string& m_buffer;
+        std::string_view m_first;
+        unsigned m_parts = 0;
+
+    public:
+        LineParts(std::string_view text, std::pmr::string& buffer)
+            : m_text(text),
+              m_buffer(buffer) {
+        }
+
+        void Keep(std::size_t begin, std::size_t end) {
+            if (begin >= end) {
+                return;
+            }
+            auto part = m_text.substr(begin, end - begin);
+            if (m_parts == 0) {
+                m_first = part;
+            } else {
+                if (m_parts == 1) {
+                    m_buffer.assign(m_first);
+                }
+                m_buffer.append(part);
+            }
+            m_parts++;
+        }
+
+        std::string_view Get() const {
+            return m_parts <= 1 ? m_first : std::string_view(m_buffer);
+        }
+
+        void Clear() {
+            m_first = {};
+            m_parts = 0;
+        }
+    };
+}
+
+SourceLexer::SourceLexer(const Syntax& syntax)
+    : m_syntax(syntax) {
+    m_actions.fill(None);
+    auto add = [this](char c, Action action) {
+        if (c != '\0') {
+            m_actions[static_cast<unsigned char>(c)] = action;
+        }
+    };
+    if (!m_syntax.lineComment.empty()) {
+        add(m_syntax.lineComment[0], Comment);
+    }
+    if (!m_syntax.blockCommentBegin.empty()) {
+        add(m_syntax.blockCommentBegin[0], Comment);
+    }
+    for (auto quote : m_syntax.quotes) {
+        add(quote, Quote);
+    }
+    add(m_syntax.tick, Tick);
+    add('\n', Newline);
+
+    // the characters with an action are the ones the scan stops at
+    m_stops.fill('\n');
+    std::size_t numStops = 0;
+    for (unsigned c = 0; c < m_actions.size(); c++) {
+        if (m_actions[c] != None) {
+            if (numStops == m_stops.size()) {
+                throw std::invalid_argument("Too many special characters in syntax");
+            }
+            m_stops[numStops++] = static_cast<char>(c);
+        }
+    }
+
+    m_blockCommentStops.fill('\n');
+    if (!m_syntax.blockCommentEnd.empty()) {
+        m_blockCommentStops[1] = m_syntax.blockCommentEnd[0];
+    }
+}
+
+const SourceLexer& SourceLexer::CStyle() {
+    static const SourceLexer lexer({ "//", "/*", "*/", { '"', '\'' }, '\\', '\0' });
+    return lexer;
+}
+
+const SourceLexer& SourceLexer::Ada() {
+    static const SourceLexer lexer({ "--", "", "", { '"', '\0' }, '\0', '\'' });
+    return lexer;
+}
+
+const SourceLexer& SourceLexer::VisualBasic() {
+    static const SourceLexer lexer({ "'", "", "", { '"', '\0' }, '\0', '\0' });
+    return lexer;
+}
+
+const SourceLexer& SourceLexer::Assembler() {
+    static const SourceLexer lexer({ ";", "", "", { '"', '\0' }, '\\', '\0' });
+    return lexer;
+}
+
+const SourceLexer& SourceLexer::Plain() {
+    static const SourceLexer lexer({ "", "", "", { '\0', '\0' }, '\0', '\0' });
+    return lexer;
+}
+
+std::size_t SourceLexer::SkipLiteral(std::string_view text, std::size_t pos) const {
+    char quote = text[pos];
+    char escape = m_syntax.escape != '\0' ? m_syntax.escape : quote;
+    std::array<char, 4> stops{ quote, '\n', escape, quote };
+    pos++;
+    for (;;) {
+        pos = LineKernel::FindFirstOf(text, pos, stops);
+        // a literal that is not closed ends with its line
+        if (pos == text.size() || text[pos] == '\n') {
+            return pos;
+        }
+        if (text[pos] == quote) {
+            return pos + 1;
+        }
+        pos += pos + 1 < text.size() && text[pos + 1] != '\n' ? 2 : 1;
+    }
+}
+
+void SourceLexer::ForEachLine(
+    std::string_view text,
+    std::pmr::string& buffer,
+    const std::function<void(std::string_view, int)>& f) const {
+
+    LineParts line(text, buffer);
+    int index = 0;
+    std::size_t pos = 0;
+    std::size_t keepFrom = 0;
+    bool inBlockComment = false;
+
+    auto endLine = [&](std::size_t newline) {
+        f(line.Get(), index++);
+        line.Clear();
+        keepFrom = newline + 1;
+    };
+
+    for (;;) {
+        if (inBlockComment) {
+            pos = LineKernel::FindFirstOf(text, pos, m_blockCommentStops);
+            if (pos == text.size()) {
+                f(line.Get(), index);
+                return;
+            }
+            if (text[pos] == '\n') {
+                endLine(pos);
+                pos++;
+            } else if (text.substr(pos).starts_with(m_syntax.blockCommentEnd)) {
+                pos += m_syntax.blockCommentEnd.size();
+                keepFrom = pos;
+                inBlockComment = false;
+            } else {
+                pos++;
+            }
+            continue;
+        }
+
+        pos = LineKernel::FindFirstOf(text, pos, m_stops);
+        if (pos == text.size()) {
+            line.Keep(keepFrom, pos);
+            f(line.Get(), index);
+            return;
+        }
+
+        switch (m_actions[static_cast<unsigned char>(text[pos])]) {
+        case Newline:
+            line.Keep(keepFrom, pos);
+            endLine(pos);
+            pos++;
+            break;
+        case Comment: {
+            auto rest = text.substr(pos);
+            if (!m_syntax.lineComment.empty() && rest.starts_with(m_syntax.lineComment)) {
+                line.Keep(keepFrom, pos);
+                pos = text.find('\n', pos);
+                if (pos == std::string_view::npos) {
+                    f(line.Get(), index);
+                    return;
+                }
+                endLine(pos);
+                pos++;
+            } else if (!m_syntax.blockCommentBegin.empty() && rest.starts_with(m_syntax.blockCommentBegin)) {
+                line.Keep(keepFrom, pos);
+                pos += m_syntax.blockCommentBegin.size();
+                inBlockComment = true;
+            } else {
+                pos++;
+            }
+            break;
+        }
+        case Quote:
+            pos = SkipLiteral(text, pos);
+            break;
+        case Tick:
+            pos += pos + 2 < text.size() && text[pos + 1] != '\n' && text[pos + 2] == m_syntax.tick ? 3 : 1;
+            break;
+        default:
+            pos++;
+            break;
+        }
+    }
+}
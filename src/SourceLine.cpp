@@ -1,22 +1,23 @@
 #include "SourceLine.h"
-#include "HashUtil.h"
+#include "LineKernel.h"
 
-#include <algorithm>
-#include <iterator>
-
-SourceLine::SourceLine(const std::string& line, int lineNumber)
-    : m_line(line),
-      m_lineNumber(lineNumber) {
+SourceLine::SourceLine(std::string_view line, int lineNumber, const allocator_type& allocator)
+    : m_line(line, allocator),
+      m_lineNumber(lineNumber),
+      // Skips all white space and noise (tabs etc) while hashing
+      m_hash(LineKernel::HashNonBlank(line)) {
+}
 
-    std::string cleanLine;
+SourceLine::SourceLine(const SourceLine& other, const allocator_type& allocator)
+    : m_line(other.m_line, allocator),
+      m_lineNumber(other.m_lineNumber),
+      m_hash(other.m_hash) {
+}
 
-    // Remove all white space and noise (tabs etc)
-    std::copy_if(
-        std::begin(line),
-        std::end(line),
-        std::back_inserter(cleanLine),
-        [](char c) { return c > ' '; });
-    m_hash = HashUtil::Hash(cleanLine.c_str(), cleanLine.size());
+SourceLine::SourceLine(SourceLine&& other, const allocator_type& allocator)
+    : m_line(std::move(other.m_line), allocator),
+      m_lineNumber(other.m_lineNumber),
+      m_hash(other.m_hash) {
 }
 
 int SourceLine::GetLineNumber() const {
@@ -27,10 +28,10 @@ bool SourceLine::operator==(const SourceLine& other) const {
     return m_hash == other.m_hash;
 }
 
-const std::string& SourceLine::GetLine() const {
+std::string_view SourceLine::GetLine() const {
     return m_line;
 }
 
-unsigned long SourceLine::GetHash() const {
+std::uint64_t SourceLine::GetHash() const {
     return m_hash;
 }
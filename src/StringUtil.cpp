@@ -17,6 +17,16 @@ std::string StringUtil::Trim(const std::string& input) {
     return input.substr(l_idx, r_idx - l_idx + 1);
 }
 
+std::string_view StringUtil::Trim(std::string_view input) {
+    auto l_idx = input.find_first_not_of(" \t");
+    if (l_idx == std::string_view::npos) {
+        return {};
+    }
+
+    auto r_idx = input.find_last_not_of(" \t");
+    return input.substr(l_idx, r_idx - l_idx + 1);
+}
+
 int StringUtil::Split(const std::string& input, const std::string& delimiter, std::vector<std::string>& results, bool doTrim) {
     auto sizeDelim = delimiter.size();
     auto newPos = input.find(delimiter, 0);
@@ -104,6 +114,22 @@ std::string StringUtil::ToLower(const std::string& s) {
     return copy;
 }
 
+std::size_t StringUtil::FindNoCase(std::string_view text, std::string_view lower, std::size_t pos) {
+    if (pos > text.size() || lower.size() > text.size() - pos) {
+        return std::string_view::npos;
+    }
+    for (auto i = pos; i + lower.size() <= text.size(); i++) {
+        std::size_t j = 0;
+        while (j < lower.size() && facet.tolower(text[i + j]) == lower[j]) {
+            j++;
+        }
+        if (j == lower.size()) {
+            return i;
+        }
+    }
+    return std::string_view::npos;
+}
+
 std::string StringUtil::GetFileExtension(const std::string& filename) {
     auto trimFileName = Trim(filename);
     auto DotPos = trimFileName.find_last_of('.');
@@ -0,0 +1,218 @@
+#include "SuffixArray.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <tuple>
+
+namespace {
+    constexpr unsigned NO_RANK = ~0u;
+
+    // Stable counting sort of the suffixes in `in` by key[suffix].
+    void CountingSort(
+        const std::vector<unsigned>& in,
+        const std::vector<unsigned>& key,
+        unsigned numKeys,
+        std::vector<unsigned>& out,
+        std::vector<unsigned>& counts) {
+        counts.assign(numKeys + 1, 0);
+        for (auto suffix : in) {
+            counts[key[suffix] + 1]++;
+        }
+        for (unsigned k = 0; k < numKeys; k++) {
+            counts[k + 1] += counts[k];
+        }
+        for (auto suffix : in) {
+            out[counts[key[suffix]]++] = suffix;
+        }
+    }
+
+    // Position of a block relative to the diagonal walk of a file pair, see
+    // ProcessSparse in Duplo.cpp.
+    std::tuple<bool, unsigned, unsigned> DiagonalKey(const Block& block) {
+        if (block.m_line1 >= block.m_line2) {
+            return { false, block.m_line1 - block.m_line2, block.m_line2 };
+        }
+        return { true, block.m_line2 - block.m_line1, block.m_line1 };
+    }
+}
+
+std::vector<unsigned> SuffixArray::Build(const std::vector<unsigned>& text, unsigned alphabetSize) {
+    unsigned n = text.size();
+    std::vector<unsigned> sa(n);
+    std::vector<unsigned> rank(text);
+    std::vector<unsigned> bySecond(n);
+    std::vector<unsigned> next(n);
+    std::vector<unsigned> counts;
+
+    for (unsigned i = 0; i < n; i++) {
+        bySecond[i] = i;
+    }
+    CountingSort(bySecond, rank, alphabetSize, sa, counts);
+
+    unsigned numRanks = alphabetSize;
+    for (unsigned k = 1; k < n; k <<= 1) {
+        // order by the rank of the second half: suffixes without one first
+        unsigned p = 0;
+        for (unsigned i = n - k; i < n; i++) {
+            bySecond[p++] = i;
+        }
+        for (auto suffix : sa) {
+            if (suffix >= k) {
+                bySecond[p++] = suffix - k;
+            }
+        }
+
+        // then by the rank of the first half, keeping the order above
+        CountingSort(bySecond, rank, numRanks, sa, counts);
+
+        next[sa[0]] = 0;
+        for (unsigned i = 1; i < n; i++) {
+            unsigned a = sa[i - 1];
+            unsigned b = sa[i];
+            bool same = rank[a] == rank[b]
+                && (a + k < n ? rank[a + k] : NO_RANK) == (b + k < n ? rank[b + k] : NO_RANK);
+            next[b] = next[a] + (same ? 0 : 1);
+        }
+        rank.swap(next);
+
+        numRanks = rank[sa[n - 1]] + 1;
+        if (numRanks == n) {
+            break;
+        }
+    }
+
+    return sa;
+}
+
+std::vector<unsigned> SuffixArray::BuildLcp(const std::vector<unsigned>& text, const std::vector<unsigned>& sa) {
+    unsigned n = text.size();
+    std::vector<unsigned> rank(n);
+    for (unsigned i = 0; i < n; i++) {
+        rank[sa[i]] = i;
+    }
+
+    std::vector<unsigned> lcp(n, 0);
+    unsigned h = 0;
+    for (unsigned i = 0; i < n; i++) {
+        if (rank[i] == 0) {
+            h = 0;
+            continue;
+        }
+        unsigned j = sa[rank[i] - 1];
+        while (i + h < n && j + h < n && text[i + h] == text[j + h]) {
+            h++;
+        }
+        lcp[rank[i]] = h;
+        if (h > 0) {
+            h--;
+        }
+    }
+
+    return lcp;
+}
+
+std::vector<Block> SuffixArray::FindBlocks(
+    std::vector<SourceFile>::const_iterator first,
+    std::vector<SourceFile>::const_iterator last,
+    const Options& options) {
+
+    unsigned numFiles = std::distance(first, last);
+
+    // Map the line hashes onto a dense alphabet. Every file is followed by
+    // its own separator so that no repeat crosses a file boundary.
+    std::vector<std::uint64_t> hashes;
+    for (auto it = first; it != last; ++it) {
+        for (size_t i = 0; i < it->GetNumOfLines(); i++) {
+            hashes.push_back(it->GetHash(i));
+        }
+    }
+    std::sort(std::begin(hashes), std::end(hashes));
+    hashes.erase(std::unique(std::begin(hashes), std::end(hashes)), std::end(hashes));
+
+    unsigned numSymbols = hashes.size();
+    std::vector<unsigned> text;
+    std::vector<unsigned> fileStarts;
+    for (auto it = first; it != last; ++it) {
+        fileStarts.push_back(text.size());
+        for (size_t i = 0; i < it->GetNumOfLines(); i++) {
+            auto hash = it->GetHash(i);
+            text.push_back(std::lower_bound(std::begin(hashes), std::end(hashes), hash) - std::begin(hashes));
+        }
+        text.push_back(numSymbols + fileStarts.size() - 1);
+    }
+    hashes = {};
+
+    std::vector<Block> blocks;
+    if (text.empty()) {
+        return blocks;
+    }
+
+    auto sa = Build(text, numSymbols + numFiles);
+    auto lcp = BuildLcp(text, sa);
+
+    auto fileIndex = [&fileStarts](unsigned pos) -> unsigned {
+        return std::upper_bound(std::begin(fileStarts), std::end(fileStarts), pos) - std::begin(fileStarts) - 1;
+    };
+
+    unsigned minBlockSize = options.GetMinBlockSize();
+    unsigned n = text.size();
+
+    // Every pair of suffixes inside a run of lcp >= minBlockSize shares at
+    // least minBlockSize lines. The pair is a maximal repeat if it can not be
+    // extended to the left, its length is the smallest lcp between them.
+    for (unsigned i = 1; i < n; i++) {
+        if (lcp[i] < minBlockSize || lcp[i] == 0) {
+            continue;
+        }
+
+        unsigned end = i;
+        while (end + 1 < n && lcp[end + 1] >= minBlockSize) {
+            end++;
+        }
+
+        for (unsigned p = i - 1; p < end; p++) {
+            unsigned length = lcp[p + 1];
+            for (unsigned q = p + 1; q <= end; q++) {
+                length = std::min(length, lcp[q]);
+                unsigned a = sa[p];
+                unsigned b = sa[q];
+                if (a > 0 && b > 0 && text[a - 1] == text[b - 1]) {
+                    continue;
+                }
+
+                unsigned fileA = fileIndex(a);
+                unsigned fileB = fileIndex(b);
+                unsigned lineA = a - fileStarts[fileA];
+                unsigned lineB = b - fileStarts[fileB];
+                if (fileA > fileB || (fileA == fileB && lineA < lineB)) {
+                    std::swap(fileA, fileB);
+                    std::swap(lineA, lineB);
+                }
+
+                auto const& source1 = *std::next(first, fileA);
+                auto const& source2 = *std::next(first, fileB);
+                if (fileA != fileB) {
+                    if (options.GetIgnoreSameFilename() && StringUtil::IsSameFilename(source1, source2)) {
+                        continue;
+                    }
+                    // the same file listed twice is compared like a file with itself
+                    if (source1 == source2 && lineA <= lineB) {
+                        continue;
+                    }
+                }
+
+                blocks.emplace_back(&source1, &source2, lineA, lineB, length);
+            }
+        }
+
+        i = end;
+    }
+
+    auto base = &*first;
+    std::sort(std::begin(blocks), std::end(blocks), [base](Block const& l, Block const& r) {
+        return std::tuple(l.m_source1 - base, l.m_source2 - base, DiagonalKey(l))
+            < std::tuple(r.m_source1 - base, r.m_source2 - base, DiagonalKey(r));
+    });
+
+    return blocks;
+}
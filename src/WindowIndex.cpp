@@ -0,0 +1,125 @@
+#include "WindowIndex.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <tuple>
+
+namespace {
+    // odd multiplier of the polynomial rolling fingerprint (mod 2^64)
+    constexpr std::uint64_t FINGERPRINT_BASE = 0x9E3779B97F4A7C15ULL;
+
+    struct Seed {
+        unsigned file;
+        bool upper;
+        unsigned diagonal;
+        unsigned start;
+
+        bool operator<(const Seed& other) const {
+            return std::tie(file, upper, diagonal, start)
+                < std::tie(other.file, other.upper, other.diagonal, other.start);
+        }
+    };
+}
+
+bool WindowIndex::Window::operator<(const Window& other) const {
+    return std::tie(fingerprint, file, line) < std::tie(other.fingerprint, other.file, other.line);
+}
+
+template <typename F>
+void WindowIndex::ForEachWindow(const SourceFile& file, F f) const {
+    unsigned numLines = file.GetNumOfLines();
+    if (m_windowSize == 0 || numLines < m_windowSize) {
+        return;
+    }
+
+    std::uint64_t outFactor = 1;
+    for (unsigned i = 0; i < m_windowSize; i++) {
+        outFactor *= FINGERPRINT_BASE;
+    }
+
+    std::uint64_t fingerprint = 0;
+    for (unsigned i = 0; i < numLines; i++) {
+        fingerprint = fingerprint * FINGERPRINT_BASE + file.GetHash(i);
+        if (i >= m_windowSize) {
+            fingerprint -= outFactor * file.GetHash(i - m_windowSize);
+        }
+        if (i + 1 >= m_windowSize) {
+            f(fingerprint, i + 1 - m_windowSize);
+        }
+    }
+}
+
+WindowIndex::WindowIndex(
+    std::vector<SourceFile>::const_iterator first,
+    std::vector<SourceFile>::const_iterator last,
+    unsigned windowSize)
+    : m_first(first),
+      m_windowSize(windowSize) {
+    for (auto it = first; it != last; ++it) {
+        unsigned file = std::distance(first, it);
+        ForEachWindow(*it, [this, file](std::uint64_t fingerprint, unsigned line) {
+            m_windows.push_back({ fingerprint, file, line });
+        });
+    }
+    std::sort(std::begin(m_windows), std::end(m_windows));
+}
+
+std::vector<Block> WindowIndex::FindBlocks(std::vector<SourceFile>::const_iterator file, const Options& options) const {
+    unsigned left = std::distance(m_first, file);
+    auto const& source1 = *file;
+
+    // a pair of equal windows is a seed when the lines before them differ,
+    // so that every maximal run is kept once on its diagonal like in
+    // ProcessSparse, and sorting the seeds yields the reporting order
+    std::vector<Seed> seeds;
+    ForEachWindow(source1, [&](std::uint64_t fingerprint, unsigned y) {
+        auto first = std::lower_bound(
+            std::begin(m_windows),
+            std::end(m_windows),
+            Window{ fingerprint, left, 0 });
+        for (auto it = first; it != std::end(m_windows) && it->fingerprint == fingerprint; ++it) {
+            unsigned x = it->line;
+            if (it->file == left && x >= y) {
+                continue;
+            }
+            if (y > 0 && x > 0 && source1.GetHash(y - 1) == std::next(m_first, it->file)->GetHash(x - 1)) {
+                continue;
+            }
+            if (y >= x) {
+                seeds.push_back({ it->file, false, y - x, x });
+            } else {
+                seeds.push_back({ it->file, true, x - y, y });
+            }
+        }
+    });
+    std::sort(std::begin(seeds), std::end(seeds));
+
+    // extend every seed to its maximal run
+    std::vector<Block> blocks;
+    for (auto const& seed : seeds) {
+        auto const& source2 = *std::next(m_first, seed.file);
+        if (seed.file != left) {
+            if (options.GetIgnoreSameFilename() && StringUtil::IsSameFilename(source1, source2)) {
+                continue;
+            }
+            // the same file listed twice is compared like a file with itself
+            if (source1 == source2 && (seed.upper || seed.diagonal == 0)) {
+                continue;
+            }
+        }
+
+        unsigned y = seed.upper ? seed.start : seed.start + seed.diagonal;
+        unsigned x = seed.upper ? seed.start + seed.diagonal : seed.start;
+        unsigned length = 0;
+        while (y + length < source1.GetNumOfLines()
+            && x + length < source2.GetNumOfLines()
+            && source1.GetHash(y + length) == source2.GetHash(x + length)) {
+            length++;
+        }
+        if (length >= m_windowSize) {
+            blocks.emplace_back(&source1, &source2, y, x, length);
+        }
+    }
+
+    return blocks;
+}
@@ -1,9 +1,61 @@
 #include "Block.h"
 #include "XmlExporter.h"
-#include "Utils.h"
 
 #include <iostream>
 
+namespace {
+    // replaces the characters that upset an XML parser in one pass, " is
+    // written as '
+    void WriteEscaped(std::ostream& out, std::string_view text) {
+        std::size_t begin = 0;
+        for (std::size_t i = 0; i < text.size(); i++) {
+            std::string_view replacement;
+            switch (text[i]) {
+            case '"':
+                replacement = "'";
+                break;
+            case '&':
+                replacement = "&amp;";
+                break;
+            case '<':
+                replacement = "&lt;";
+                break;
+            case '>':
+                replacement = "&gt;";
+                break;
+            default:
+                continue;
+            }
+            out << text.substr(begin, i - begin) << replacement;
+            begin = i + 1;
+        }
+        out << text.substr(begin);
+    }
+
+    void WriteBlock(std::ostream& out, const SourceFile& source, int line, int count) {
+        int startLineNumber = source.GetLineNumber(line);
+        int endLineNumber = source.GetLineNumber(line + count - 1);
+        out
+            << "        <block SourceFile=\"" << source.GetFilename()
+            << "\" StartLineNumber=\"" << startLineNumber
+            << "\" EndLineNumber=\"" << endLineNumber << "\"/>"
+            << '\n';
+    }
+
+    void WriteLines(std::ostream& out, const SourceFile& source, int line, int count) {
+        out
+            << "        <lines xml:space=\"preserve\">"
+            << '\n';
+        for (int j = 0; j < count; j++) {
+            out << "            <line Text=\"";
+            WriteEscaped(out, source.GetLine(j + line).GetLine());
+            out << "\"/>" << '\n';
+        }
+
+        out << "        </lines>" << '\n';
+    }
+}
+
 XmlExporter::XmlExporter(const Options& options)
     : FileExporter(options, false) {
 }
@@ -15,9 +67,9 @@ void XmlExporter::LogMessage(const std::string& message) {
 void XmlExporter::WriteHeader() {
     Out()
         << "<?xml version=\"1.0\"?>"
-        << std::endl
+        << '\n'
         << "<duplo>"
-        << std::endl;
+        << '\n';
 }
 
 void XmlExporter::WriteFooter(
@@ -28,7 +80,7 @@ void XmlExporter::WriteFooter(
     unsigned /*tot_dup_lines*/) {
     Out()
         << "</duplo>"
-        << std::endl;
+        << '\n';
 }
 
 void XmlExporter::ReportSeq(
@@ -39,43 +91,21 @@ void XmlExporter::ReportSeq(
     const SourceFile& source2) {
     Out()
         << "    <set LineCount=\"" << count << "\">"
-        << std::endl;
-    int startLineNumber1 = source1.GetLine(line1).GetLineNumber();
-    int endLineNumber1 = source1.GetLine(line1 + count - 1).GetLineNumber();
-    Out()
-        << "        <block SourceFile=\"" << source1.GetFilename()
-        << "\" StartLineNumber=\"" << startLineNumber1
-        << "\" EndLineNumber=\"" << endLineNumber1 << "\"/>"
-        << std::endl;
-    int startLineNumber2 = source2.GetLine(line2).GetLineNumber();
-    int endLineNumber2 = source2.GetLine(line2 + count - 1).GetLineNumber();
-    Out()
-        << "        <block SourceFile=\"" << source2.GetFilename()
-        << "\" StartLineNumber=\"" << startLineNumber2
-        << "\" EndLineNumber=\"" << endLineNumber2 << "\"/>"
-        << std::endl;
-    Out()
-        << "        <lines xml:space=\"preserve\">"
-        << std::endl;
-    for (int j = 0; j < count; j++) {
-        // replace various characters/ strings so that it doesn't upset the XML parser
-        std::string tmpstr = source1.GetLine(j + line1).GetLine();
-
-        // " --> '
-        StringUtil::StrSub(tmpstr, "\'", "\"", -1);
-
-        // & --> &amp;
-        StringUtil::StrSub(tmpstr, "&amp;", "&", -1);
-
-        // < --> &lt;
-        StringUtil::StrSub(tmpstr, "&lt;", "<", -1);
-
-        // > --> &gt;
-        StringUtil::StrSub(tmpstr, "&gt;", ">", -1);
+        << '\n';
+    WriteBlock(Out(), source1, line1, count);
+    WriteBlock(Out(), source2, line2, count);
+    WriteLines(Out(), source1, line1, count);
+    Out() << "    </set>" << '\n';
+}
 
-        Out() << "            <line Text=\"" << tmpstr << "\"/>" << std::endl;
+void XmlExporter::ReportClass(const CloneClass& cloneClass) {
+    Out()
+        << "    <set LineCount=\"" << cloneClass.m_count << "\">"
+        << '\n';
+    for (auto const& location : cloneClass.m_locations) {
+        WriteBlock(Out(), *location.m_source, location.m_line, cloneClass.m_count);
     }
-
-    Out() << "        </lines>" << std::endl;
-    Out() << "    </set>" << std::endl;
+    auto const& first = cloneClass.m_locations.front();
+    WriteLines(Out(), *first.m_source, first.m_line, cloneClass.m_count);
+    Out() << "    </set>" << '\n';
 }
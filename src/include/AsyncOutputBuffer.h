@@ -0,0 +1,52 @@
+#ifndef _ASYNCOUTPUTBUFFER_H_
+#define _ASYNCOUTPUTBUFFER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
+/**
+ * Stream buffer that collects the output in large chunks and writes them
+ * to the target on a thread of its own, so the threads producing the
+ * output do not wait for the disk or a pipe. Flushing the stream hands
+ * the chunk over at once and flushes the target after it is written.
+ * Only one thread at a time may write to it.
+ */
+class AsyncOutputBuffer : public std::streambuf {
+    struct Chunk {
+        std::unique_ptr<char[]> data;
+        std::size_t size;
+        bool flush;
+    };
+
+    std::streambuf* m_target;
+    std::unique_ptr<char[]> m_buffer;
+    std::mutex m_mutex;
+    std::condition_variable m_queued;
+    std::condition_variable m_written;
+    std::deque<Chunk> m_queue;
+    std::vector<std::unique_ptr<char[]>> m_spare;
+    bool m_stop = false;
+    std::thread m_writer;
+
+    void Submit(bool flush);
+    void Write();
+
+protected:
+    int_type overflow(int_type c) override;
+    int sync() override;
+
+public:
+    explicit AsyncOutputBuffer(std::streambuf* target);
+    ~AsyncOutputBuffer() override;
+
+    AsyncOutputBuffer(const AsyncOutputBuffer&) = delete;
+    AsyncOutputBuffer& operator=(const AsyncOutputBuffer&) = delete;
+};
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef _BINARYEXPORTER_H_
+#define _BINARYEXPORTER_H_
+
+#include "FileExporter.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Writes the blocks in the compact format of BinaryReport. Files and the
+ * text of blocks are written once and referred to by their id.
+ */
+class BinaryExporter : public FileExporter {
+    // where a text was first seen, it is compared with the lines there
+    struct Text {
+        const SourceFile* source;
+        int line;
+        int count;
+    };
+
+    std::string m_buffer;
+    std::unordered_map<const SourceFile*, std::uint32_t> m_fileIds;
+    std::unordered_multimap<std::uint64_t, std::uint32_t> m_textIds;
+    std::vector<Text> m_texts;
+
+    std::uint32_t GetFileId(const SourceFile& source);
+    std::uint32_t GetTextId(const SourceFile& source, int line, int count);
+
+public:
+    BinaryExporter(const Options& options);
+    void LogMessage(const std::string& message) override;
+    void WriteHeader() override;
+    void WriteFooter(
+        const Options& options,
+        int files,
+        long locsTotal,
+        unsigned tot_dup_blocks,
+        unsigned tot_dup_lines) override;
+    void ReportSeq(
+        int line1,
+        int line2,
+        int count,
+        const SourceFile& source1,
+        const SourceFile& source2) override;
+    void ReportClass(const CloneClass& cloneClass) override;
+};
+
+#endif
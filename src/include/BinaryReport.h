@@ -0,0 +1,47 @@
+#ifndef _BINARYREPORT_H_
+#define _BINARYREPORT_H_
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <string_view>
+
+/**
+ * Layout of the binary report. It starts with the magic and the version,
+ * followed by records that each start with their kind:
+ *
+ *   File   name                        (ids count up from 0)
+ *   Text   number of lines, lines      (ids count up from 0)
+ *   Block  text id, file id 1, start 1, end 1, file id 2, start 2, end 2
+ *   Class  text id, number of locations, file id, start, end of each
+ *   End
+ *
+ * A file or text record comes before the first block that refers to it,
+ * so every text is written once however many blocks share it. Numbers are
+ * unsigned LEB128 and strings are their length followed by their bytes.
+ */
+namespace BinaryReport {
+    // bump when the layout changes, version 2 added Class records
+    constexpr std::uint32_t VERSION = 2;
+    constexpr std::string_view MAGIC = "DUPLOREP";
+
+    enum class Record : char {
+        File = 'F',
+        Text = 'T',
+        Block = 'B',
+        Class = 'C',
+        End = 'E'
+    };
+
+    void AppendNumber(std::string& out, std::uint64_t value);
+    void AppendString(std::string& out, std::string_view text);
+
+    /**
+     * Read from a report, these throw when it ends too early.
+     */
+    std::uint64_t ReadNumber(std::istream& in);
+    std::string ReadString(std::istream& in);
+    Record ReadRecord(std::istream& in);
+}
+
+#endif
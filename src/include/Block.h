@@ -3,6 +3,8 @@
 
 #include "SourceFile.h"
 
+#include <vector>
+
 class Block {
 public:
     SourceFile const* m_source1;
@@ -23,4 +25,19 @@ public:
             m_count{ count } {}
 };
 
+/**
+ * The same m_count lines at every location, found by grouping the blocks
+ * that share their ends.
+ */
+class CloneClass {
+public:
+    struct Location {
+        SourceFile const* m_source;
+        unsigned m_line;
+    };
+
+    std::vector<Location> m_locations;
+    unsigned m_count;
+};
+
 #endif
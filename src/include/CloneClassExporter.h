@@ -0,0 +1,38 @@
+#ifndef _CLONECLASSEXPORTER_H_
+#define _CLONECLASSEXPORTER_H_
+
+#include "Block.h"
+#include "IExporter.h"
+
+#include <vector>
+
+/**
+ * Collects the reported blocks and groups the ones that share their ends
+ * into clone classes, so that n copies of the same lines are reported once
+ * instead of as n(n-1)/2 blocks. The classes are handed to the exporter it
+ * wraps before its footer, the files have to be alive until then.
+ */
+class CloneClassExporter : public IExporter {
+    IExporterPtr m_exporter;
+    std::vector<Block> m_blocks;
+
+public:
+    explicit CloneClassExporter(IExporterPtr exporter);
+    void LogMessage(const std::string& message) override;
+    void WriteHeader() override;
+    void WriteFooter(
+        const Options& options,
+        int files,
+        long locsTotal,
+        unsigned tot_dup_blocks,
+        unsigned tot_dup_lines) override;
+    void ReportSeq(
+        int line1,
+        int line2,
+        int count,
+        const SourceFile& source1,
+        const SourceFile& source2) override;
+    void ReportClass(const CloneClass& cloneClass) override;
+};
+
+#endif
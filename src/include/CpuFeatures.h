@@ -0,0 +1,15 @@
+#ifndef _CPUFEATURES_H_
+#define _CPUFEATURES_H_
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define DUPLO_X86_64
+#endif
+
+namespace CpuFeatures {
+    /**
+     * Whether both the CPU and the operating system support AVX2.
+     */
+    bool HasAvx2();
+}
+
+#endif
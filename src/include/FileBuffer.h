@@ -0,0 +1,28 @@
+#ifndef _FILEBUFFER_H_
+#define _FILEBUFFER_H_
+
+#include <string>
+#include <string_view>
+
+/**
+ * Read-only contents of a file. Regular files are memory mapped where the
+ * platform supports it, everything else is read into memory.
+ */
+class FileBuffer {
+    std::string m_contents;
+    void* m_mapping;
+    std::size_t m_size;
+
+    void ReadAll(const std::string& filename);
+
+public:
+    FileBuffer(const std::string& filename);
+    ~FileBuffer();
+
+    FileBuffer(const FileBuffer&) = delete;
+    FileBuffer& operator=(const FileBuffer&) = delete;
+
+    std::string_view GetData() const;
+};
+
+#endif
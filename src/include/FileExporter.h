@@ -1,12 +1,16 @@
 #ifndef _FILEEXPORTER_H_
 #define _FILEEXPORTER_H_
 
+#include "AsyncOutputBuffer.h"
 #include "IExporter.h"
 
 #include <fstream>
 
 class FileExporter : public IExporter {
     std::ofstream m_of;
+    // written on a thread of its own, the log shares it when both go to
+    // the same stream to keep their order
+    std::unique_ptr<AsyncOutputBuffer> m_sink;
     std::shared_ptr<std::ostream> m_out;
     std::shared_ptr<std::ostream> m_log;
 
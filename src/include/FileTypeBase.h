@@ -2,22 +2,25 @@
 #define _FILETYPEBASE_H_
 
 #include "IFileType.h"
-#include "ILineFilter.h"
+#include "SourceLexer.h"
 
 class FileTypeBase : public IFileType {
     bool m_ignorePrepStuff;
     unsigned m_minChars;
 
-    bool IsSourceLine(const std::string& line) const;
+    bool IsSourceLine(std::string_view line) const;
 
-    virtual ILineFilterPtr CreateLineFilter() const = 0;
-    virtual std::string GetCleanLine(const std::string& line) const = 0;
-    virtual bool IsPreprocessorDirective(const std::string& line) const = 0;
+    virtual const SourceLexer& GetLexer() const = 0;
+    virtual bool IsPreprocessorDirective(std::string_view line) const = 0;
 
 public:
 
     FileTypeBase(bool ignorePrepStuff, unsigned minChars);
-    std::vector<SourceLine> GetCleanedSourceLines(const std::vector<std::string>&) const override;
+    void ForEachCleanedSourceLine(
+        std::string_view text,
+        const std::function<void(std::string_view, int)>& f,
+        std::pmr::memory_resource* resource) const override;
+    void GetCleanedSourceLines(std::string_view text, std::pmr::vector<SourceLine>& lines) const override;
 };
 
 #endif
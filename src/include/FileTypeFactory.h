@@ -6,6 +6,9 @@
 #include <string>
 
 namespace FileTypeFactory {
+    /**
+     * File type of a file by its extension, files of the same type share it.
+     */
     IFileTypePtr CreateFileType(
         const std::string& filename,
         bool ignorePrepStuff,
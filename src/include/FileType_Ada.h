@@ -6,11 +6,9 @@
 struct FileType_Ada : public FileTypeBase {
     FileType_Ada(bool ignorePrepStuff, unsigned minChars);
 
-    ILineFilterPtr CreateLineFilter() const override;
+    const SourceLexer& GetLexer() const override;
 
-    std::string GetCleanLine(const std::string& line) const override;
-
-    bool IsPreprocessorDirective(const std::string& line) const override;
+    bool IsPreprocessorDirective(std::string_view line) const override;
 };
 
 #endif
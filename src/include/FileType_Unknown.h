@@ -6,11 +6,9 @@
 struct FileType_Unknown : public FileTypeBase {
     FileType_Unknown(unsigned minChars);
 
-    ILineFilterPtr CreateLineFilter() const override;
+    const SourceLexer& GetLexer() const override;
 
-    std::string GetCleanLine(const std::string& line) const override;
-
-    bool IsPreprocessorDirective(const std::string&) const override;
+    bool IsPreprocessorDirective(std::string_view) const override;
 };
 
 #endif
@@ -0,0 +1,48 @@
+#ifndef _FINGERPRINTCACHE_H_
+#define _FINGERPRINTCACHE_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Directory with the cleaned line hashes and line numbers of source files,
+ * so that unchanged files are not read and filtered again. An entry is only
+ * used when the path, size and modification time of the file and the
+ * options that affect the cleaning are the same as when it was written.
+ */
+class FingerprintCache {
+    std::string m_directory;
+    unsigned m_minChars;
+    bool m_ignorePrepStuff;
+
+    std::string GetEntryFilename(const std::string& filename) const;
+
+public:
+    struct Stamp {
+        bool valid;
+        std::uint64_t size;
+        std::int64_t modified;
+    };
+
+    FingerprintCache(const std::string& directory, unsigned minChars, bool ignorePrepStuff);
+
+    /**
+     * Size and modification time of a file, taken before it is read.
+     */
+    static Stamp GetStamp(const std::string& filename);
+
+    bool Load(
+        const std::string& filename,
+        const Stamp& stamp,
+        std::vector<std::uint64_t>& hashes,
+        std::vector<int>& lineNumbers) const;
+
+    void Store(
+        const std::string& filename,
+        const Stamp& stamp,
+        const std::vector<std::uint64_t>& hashes,
+        const std::vector<int>& lineNumbers) const;
+};
+
+#endif
@@ -1,8 +1,101 @@
 #ifndef _HASHUTIL_H_
 #define _HASHUTIL_H_
 
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/**
+ * 64-bit hash in the style of wyhash: eight bytes at a time are folded into
+ * the state with a 64x64->128 bit multiplication.
+ */
 namespace HashUtil {
-    unsigned long Hash(const char* dataToHash, unsigned long length);
+    constexpr std::uint64_t SEED = 0xa0761d6478bd642fULL;
+    constexpr std::uint64_t SECRET0 = 0xe7037ed1a0b428dbULL;
+    constexpr std::uint64_t SECRET1 = 0x8ebc6af09c88c6e3ULL;
+    constexpr std::uint64_t SECRET2 = 0x589965cc75374cc3ULL;
+
+    /**
+     * Xor of the high and the low half of the 128 bit product.
+     */
+    inline std::uint64_t Mix(std::uint64_t a, std::uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+        __extension__ typedef unsigned __int128 Product;
+        Product r = static_cast<Product>(a) * b;
+        return static_cast<std::uint64_t>(r) ^ static_cast<std::uint64_t>(r >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64) && !defined(__clang__)
+        std::uint64_t high;
+        std::uint64_t low = _umul128(a, b, &high);
+        return low ^ high;
+#else
+        std::uint64_t aLow = a & 0xFFFFFFFF, aHigh = a >> 32;
+        std::uint64_t bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+        std::uint64_t ll = aLow * bLow, lh = aLow * bHigh, hl = aHigh * bLow, hh = aHigh * bHigh;
+        std::uint64_t middle = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+        std::uint64_t low = (ll & 0xFFFFFFFF) | (middle << 32);
+        std::uint64_t high = hh + (lh >> 32) + (hl >> 32) + (middle >> 32);
+        return low ^ high;
+#endif
+    }
+
+    /**
+     * Eight bytes with the first one in the lowest byte, on any platform.
+     */
+    inline std::uint64_t Load64(const char* p) {
+        std::uint64_t word = 0;
+        for (int i = 0; i < 8; i++) {
+            word |= std::uint64_t(static_cast<unsigned char>(p[i])) << (8 * i);
+        }
+        return word;
+    }
+
+    /**
+     * Hashes bytes that are added one at a time or eight at a time, the
+     * result is the same as Hash over all of them.
+     */
+    class Hasher {
+        std::uint64_t m_state = SEED;
+        std::uint64_t m_word = 0;
+        unsigned m_pending = 0;
+        std::uint64_t m_length = 0;
+
+        void Consume(std::uint64_t word) {
+            m_state = Mix(word ^ SECRET0, m_state ^ SECRET1);
+            m_length += 8;
+        }
+
+    public:
+        void Add(char c) {
+            m_word |= std::uint64_t(static_cast<unsigned char>(c)) << (8 * m_pending);
+            if (++m_pending == 8) {
+                Consume(m_word);
+                m_word = 0;
+                m_pending = 0;
+            }
+        }
+
+        /**
+         * Adds the eight bytes of word, see Load64 for their order.
+         */
+        void Add8(std::uint64_t word) {
+            if (m_pending == 0) {
+                Consume(word);
+            } else {
+                Consume(m_word | word << (8 * m_pending));
+                m_word = word >> (64 - 8 * m_pending);
+            }
+        }
+
+        std::uint64_t Finish() const {
+            std::uint64_t length = m_length + m_pending;
+            return Mix(SECRET2 ^ length, Mix(m_word ^ SECRET1, m_state ^ SECRET2));
+        }
+    };
+
+    std::uint64_t Hash(const char* dataToHash, std::size_t length);
 };
 
 #endif
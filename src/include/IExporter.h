@@ -27,6 +27,7 @@ struct IExporter {
         int count,
         const SourceFile& source1,
         const SourceFile& source2) = 0;
+    virtual void ReportClass(const CloneClass& cloneClass) = 0;
 };
 
 #endif
@@ -3,13 +3,31 @@
 
 #include "SourceLine.h"
 
+#include <functional>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 
 struct IFileType {
     virtual ~IFileType() = default;
-    virtual std::vector<SourceLine> GetCleanedSourceLines(const std::vector<std::string>& lines) const = 0;
+
+    /**
+     * Calls f with every cleaned source line of the text of a file and the
+     * index of its line, the cleaned line is only valid during the call.
+     * Scratch memory comes from resource.
+     */
+    virtual void ForEachCleanedSourceLine(
+        std::string_view text,
+        const std::function<void(std::string_view, int)>& f,
+        std::pmr::memory_resource* resource) const = 0;
+
+    /**
+     * Appends the cleaned source lines of the text of a file to lines,
+     * they are allocated like lines.
+     */
+    virtual void GetCleanedSourceLines(std::string_view text, std::pmr::vector<SourceLine>& lines) const = 0;
 };
 
 typedef std::shared_ptr<IFileType> IFileTypePtr;
@@ -2,11 +2,28 @@
 #define _JSONEXPORTER_H_
 
 #include "FileExporter.h"
+#include "JsonWriter.h"
 
-#include <nlohmann/json.hpp>
-
+/**
+ * Writes every block as soon as it is reported, so memory does not grow
+ * with the number of blocks.
+ */
 class JsonExporter : public FileExporter {
-    nlohmann::json m_json;
+    bool m_empty = true;
+
+protected:
+    JsonWriter m_writer;
+
+    JsonExporter(const Options& options, bool pretty);
+
+    // the members of a block or a clone class, sorted by name
+    void WriteSeq(
+        int line1,
+        int line2,
+        int count,
+        const SourceFile& source1,
+        const SourceFile& source2);
+    void WriteClass(const CloneClass& cloneClass);
 
 public:
     JsonExporter(const Options& options);
@@ -24,6 +41,7 @@ public:
         int count,
         const SourceFile& source1,
         const SourceFile& source2) override;
+    void ReportClass(const CloneClass& cloneClass) override;
 };
 
 #endif
@@ -0,0 +1,54 @@
+#ifndef _JSONWRITER_H_
+#define _JSONWRITER_H_
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Writes JSON into a buffer that is handed to a stream piece by piece.
+ * Pretty output has the layout of nlohmann::json dump(2), compact output
+ * that of dump() without indentation, so members should be written in
+ * sorted order to match them.
+ */
+class JsonWriter {
+    std::string m_buffer;
+    bool m_pretty;
+    // whether each open object or array is still empty
+    std::vector<bool> m_empty;
+    bool m_afterKey = false;
+
+    void BeginValue();
+    void Begin(char bracket);
+    void End(char bracket);
+
+public:
+    explicit JsonWriter(bool pretty);
+
+    void BeginObject();
+    void EndObject();
+    void BeginArray();
+    void EndArray();
+    void Key(std::string_view key);
+    void Number(std::int64_t value);
+    void String(std::string_view text);
+    void Null();
+
+    /**
+     * Writes what was added since the last call to out.
+     */
+    void WriteTo(std::ostream& out);
+
+    /**
+     * Append text as a quoted JSON string. Characters outside of ASCII are
+     * escaped as \uXXXX and bytes that are not valid UTF-8 are left out.
+     *
+     * @param out  string to append to
+     * @param text  text to quote
+     */
+    static void AppendString(std::string& out, std::string_view text);
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef _LINEKERNEL_H_
+#define _LINEKERNEL_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Byte scanning loops of the load phase. They use SSE2 on x86-64 and AVX2
+ * when the CPU supports it, with plain loops everywhere else.
+ */
+namespace LineKernel {
+    /**
+     * Position of the first character from pos on that is one of stops, or
+     * text.size() if there is none. Fewer stops are given by repeating one.
+     */
+    std::size_t FindFirstOf(std::string_view text, std::size_t pos, const std::array<char, 4>& stops);
+
+    /**
+     * Hash of the characters of a line that are greater than ' ', the same
+     * as HashUtil::Hash of a copy that only has those characters.
+     */
+    std::uint64_t HashNonBlank(std::string_view line);
+
+    /**
+     * Whether two lines have the same characters greater than ' ', which is
+     * what equal hashes of them are meant to say.
+     */
+    bool EqualNonBlank(std::string_view line1, std::string_view line2);
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef _MATCHMATRIX_H_
+#define _MATCHMATRIX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+/**
+ * A run of matching lines on one diagonal of a file pair. Diagonals are
+ * numbered so that ascending order is the reporting order: line1 - line2
+ * for the lower half (line1 >= line2) followed by m + line2 - line1 for the
+ * upper half, start is the position along the diagonal.
+ */
+struct DiagonalBlock {
+    unsigned diagonal;
+    unsigned start;
+    unsigned length;
+
+    bool operator<(DiagonalBlock const& other) const {
+        return std::tie(diagonal, start) < std::tie(other.diagonal, other.start);
+    }
+};
+
+/**
+ * Match matrix of a file pair stored as packed 64-bit words in
+ * diagonal-major order. Only one fixed-size tile of the matrix exists at a
+ * time: the diagonals are filled into the tile until it is full, the tile
+ * is scanned, and the run that is open at its end is carried over to the
+ * next tile. Memory use does not depend on the size of the files.
+ */
+class MatchMatrix {
+    struct Segment {
+        unsigned diagonal;
+        unsigned start;
+        unsigned length;
+        std::size_t offset;
+    };
+
+    struct OpenRun {
+        unsigned diagonal;
+        unsigned start;
+        unsigned length;
+    };
+
+    std::vector<std::uint64_t> m_words;
+    std::vector<Segment> m_segments;
+    std::size_t m_used = 0;
+
+    void ScanTile(OpenRun& run, unsigned minLength, std::vector<DiagonalBlock>& runs);
+
+public:
+    /**
+     * Compares the line hashes of both files along every diagonal and
+     * appends all runs of at least minLength matching lines, in diagonal
+     * order. When comparing a file with itself only the diagonals below the
+     * main one are used.
+     */
+    void FindRuns(
+        const std::uint64_t* hashes1,
+        std::size_t m,
+        const std::uint64_t* hashes2,
+        std::size_t n,
+        bool sameFile,
+        unsigned minLength,
+        std::vector<DiagonalBlock>& runs);
+};
+
+namespace MatchKernel {
+    /**
+     * Sets bit i of words (from the least significant bit of words[0]) for
+     * every i < length where a[i] == b[i], clearing all other bits. Uses
+     * AVX2 when the CPU supports it.
+     */
+    void Compare(const std::uint64_t* a, const std::uint64_t* b, std::size_t length, std::uint64_t* words);
+}
+
+#endif
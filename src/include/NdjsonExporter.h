@@ -0,0 +1,28 @@
+#ifndef _NDJSONEXPORTER_H_
+#define _NDJSONEXPORTER_H_
+
+#include "JsonExporter.h"
+
+/**
+ * Writes every block as a JSON object of its own line, with the members of
+ * the JSON report.
+ */
+class NdjsonExporter : public JsonExporter {
+public:
+    NdjsonExporter(const Options& options);
+    void WriteFooter(
+        const Options& options,
+        int files,
+        long locsTotal,
+        unsigned tot_dup_blocks,
+        unsigned tot_dup_lines) override;
+    void ReportSeq(
+        int line1,
+        int line2,
+        int count,
+        const SourceFile& source1,
+        const SourceFile& source2) override;
+    void ReportClass(const CloneClass& cloneClass) override;
+};
+
+#endif
@@ -3,6 +3,12 @@
 
 #include <string>
 
+enum class Engine {
+    Pairwise,
+    SuffixArray,
+    WindowSeeds
+};
+
 class Options {
     unsigned m_minChars;
     bool m_ignorePrepStuff;
@@ -12,7 +18,17 @@ class Options {
     unsigned m_numThreads;
     bool m_outputXml;
     bool m_outputJSON;
+    bool m_outputNdjson;
+    bool m_outputBinary;
     bool m_ignoreSameFilename;
+    Engine m_engine;
+    unsigned m_stopLineFiles;
+    bool m_pipelined;
+    std::string m_cacheDirectory;
+    std::string m_changedListFilename;
+    bool m_verify;
+    bool m_cloneClasses;
+    bool m_prune;
     std::string m_listFilename;
     std::string m_outputFilename;
 
@@ -26,16 +42,36 @@ public:
         unsigned numThreads,
         bool outputXml,
         bool outputJSON,
+        bool outputNdjson,
+        bool outputBinary,
         bool ignoreSameFilename,
+        Engine engine,
+        unsigned stopLineFiles,
+        bool pipelined,
+        const std::string& cacheDirectory,
+        const std::string& changedListFilename,
+        bool verify,
+        bool cloneClasses,
+        bool prune,
         const std::string& listFilename,
         const std::string& outputFilename
     );
 
     bool GetIgnoreSameFilename() const;
+    Engine GetEngine() const;
+    unsigned GetStopLineFiles() const;
+    bool GetPipelined() const;
+    const std::string& GetCacheDirectory() const;
+    const std::string& GetChangedListFilename() const;
+    bool GetVerify() const;
+    bool GetCloneClasses() const;
+    bool GetPrune() const;
     const std::string& GetListFilename() const;
     const std::string& GetOutputFilename() const;
     bool GetOutputXml() const;
     bool GetOutputJSON() const;
+    bool GetOutputNdjson() const;
+    bool GetOutputBinary() const;
     unsigned GetMinChars() const;
     bool GetIgnorePrepStuff() const;
     unsigned GetMinBlockSize() const;
@@ -0,0 +1,78 @@
+#ifndef _POSTINGINDEX_H_
+#define _POSTINGINDEX_H_
+
+#include "SourceFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/**
+ * Inverted index from line hashes to the files containing them, stored as
+ * compressed sparse rows. Every file is listed once per hash, together
+ * with the number of its lines that have that hash. The hashes are spread
+ * over shards, so that the index can be built in parallel: first each file
+ * with AddFile, then each shard with BuildShard.
+ */
+class PostingIndex {
+public:
+    struct Posting {
+        unsigned file;
+        unsigned count;
+    };
+
+    struct Entry {
+        std::uint64_t hash;
+        unsigned count;
+    };
+
+private:
+    struct Shard {
+        std::vector<std::uint64_t> hashes;
+        std::vector<unsigned> offsets;
+        std::vector<Posting> postings;
+    };
+
+    // distinct hashes of every file, ordered by shard
+    std::vector<std::vector<Entry>> m_entries;
+    std::vector<Shard> m_shards;
+
+    static std::size_t ShardOf(std::uint64_t hash);
+
+public:
+    explicit PostingIndex(std::size_t numFiles);
+
+    std::size_t GetNumShards() const;
+
+    /**
+     * Collects the distinct hashes of a file, or only those in onlyHashes
+     * if it is given. Different files can be added concurrently.
+     */
+    void AddFile(unsigned file, const SourceFile& source, const std::unordered_set<std::uint64_t>* onlyHashes = nullptr);
+
+    /**
+     * Builds the posting lists of one shard once all files are added.
+     * Different shards can be built concurrently.
+     */
+    void BuildShard(std::size_t shard);
+
+    /**
+     * Distinct hashes of a file with their number of lines.
+     */
+    std::span<const Entry> GetEntries(unsigned file) const;
+
+    /**
+     * Files containing the hash, in ascending order.
+     */
+    std::span<const Posting> Find(std::uint64_t hash) const;
+
+    /**
+     * Hashes found in more than maxFiles files, with their number of files.
+     */
+    std::vector<std::pair<std::uint64_t, std::size_t>> FindFrequent(std::size_t maxFiles) const;
+};
+
+#endif
@@ -1,25 +1,45 @@
 #ifndef _SOURCEFILE_H_
 #define _SOURCEFILE_H_
 
+#include "FingerprintCache.h"
 #include "IFileType.h"
 #include "SourceLine.h"
 
+#include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <string>
 #include <vector>
 
+/**
+ * Cleaned lines of a source file. Only the hashes and line numbers are
+ * kept, the text of the lines is read again the first time it is needed.
+ */
 class SourceFile {
+    // the lines and their text are freed in one go with the file
+    struct Text {
+        std::once_flag loaded;
+        std::pmr::monotonic_buffer_resource arena;
+        std::pmr::vector<SourceLine> lines{ &arena };
+    };
+
     std::string m_filename;
     IFileTypePtr m_fileType;
-    std::vector<SourceLine> m_sourceLines;
+    std::vector<std::uint64_t> m_hashes;
+    std::vector<int> m_lineNumbers;
+    std::unique_ptr<Text> m_text;
+
+    const std::pmr::vector<SourceLine>& GetText() const;
 
 public:
-    SourceFile(const std::string& fileName, unsigned minChars, bool ignorePrepStuff);
+    SourceFile(const std::string& fileName, unsigned minChars, bool ignorePrepStuff, const FingerprintCache* cache = nullptr);
     SourceFile(SourceFile&& right) noexcept;
     SourceFile &operator=(SourceFile const &other);
 
     size_t GetNumOfLines() const;
+    std::uint64_t GetHash(int index) const;
+    int GetLineNumber(int index) const;
     const SourceLine& GetLine(int index) const;
-    std::vector<std::string> GetLines(int begin, int end) const;
     const std::string& GetFilename() const;
 
     bool operator==(const SourceFile& other) const;
@@ -0,0 +1,68 @@
+#ifndef _SOURCELEXER_H_
+#define _SOURCELEXER_H_
+
+#include <array>
+#include <functional>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+/**
+ * Removes the comments of a source file in one pass over its whole text
+ * and hands out the remaining lines. Comment markers inside string and
+ * character literals are left alone.
+ */
+class SourceLexer {
+public:
+    /**
+     * Comment and literal syntax of a language family, empty or '\0' when
+     * the language has no such thing.
+     */
+    struct Syntax {
+        std::string_view lineComment;
+        std::string_view blockCommentBegin;
+        std::string_view blockCommentEnd;
+        std::array<char, 2> quotes;
+        // quotes inside literals are escaped with it, or doubled if '\0'
+        char escape;
+        // 'x' is a character literal, other ticks are not quotes
+        char tick;
+    };
+
+    explicit SourceLexer(const Syntax& syntax);
+
+    static const SourceLexer& CStyle();
+    static const SourceLexer& Ada();
+    static const SourceLexer& VisualBasic();
+    static const SourceLexer& Assembler();
+    static const SourceLexer& Plain();
+
+    /**
+     * Calls f with every line of text without its comments and the index
+     * of the line. Lines that lost a comment in the middle are put
+     * together in buffer, the others are parts of text. A line is only
+     * valid during the call.
+     */
+    void ForEachLine(
+        std::string_view text,
+        std::pmr::string& buffer,
+        const std::function<void(std::string_view, int)>& f) const;
+
+private:
+    enum Action : unsigned char {
+        None,
+        Newline,
+        Comment,
+        Quote,
+        Tick
+    };
+
+    Syntax m_syntax;
+    std::array<Action, 256> m_actions;
+    std::array<char, 4> m_stops;
+    std::array<char, 4> m_blockCommentStops;
+
+    std::size_t SkipLiteral(std::string_view text, std::size_t pos) const;
+};
+
+#endif
@@ -1,22 +1,34 @@
 #ifndef _SOURCELINE_H_
 #define _SOURCELINE_H_
 
+#include <cstdint>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 
 class SourceLine {
-    std::string m_line;
+    std::pmr::string m_line;
     int m_lineNumber;
-    unsigned long m_hash;
+    std::uint64_t m_hash;
 
 public:
+    // the text is allocated like the container of the line
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
     /**
      * Creates a new text file. The file is accessed relative to current directory.
      */
-    SourceLine(const std::string& line, int lineNumber);
+    SourceLine(std::string_view line, int lineNumber, const allocator_type& allocator = {});
+    SourceLine(const SourceLine& other, const allocator_type& allocator);
+    SourceLine(SourceLine&& other, const allocator_type& allocator);
+    SourceLine(const SourceLine& other) = default;
+    SourceLine(SourceLine&& other) = default;
+    SourceLine& operator=(const SourceLine& other) = default;
+    SourceLine& operator=(SourceLine&& other) = default;
 
     int GetLineNumber() const;
-    const std::string& GetLine() const;
-    unsigned long GetHash() const;
+    std::string_view GetLine() const;
+    std::uint64_t GetHash() const;
     bool operator==(const SourceLine& other) const;
 };
 
@@ -0,0 +1,34 @@
+#ifndef _SUFFIXARRAY_H_
+#define _SUFFIXARRAY_H_
+
+#include "Block.h"
+#include "Options.h"
+#include "SourceFile.h"
+
+#include <vector>
+
+namespace SuffixArray {
+    /**
+     * Builds the suffix array of text using prefix doubling with radix
+     * sorting, O(N log N). All symbols must be smaller than alphabetSize.
+     */
+    std::vector<unsigned> Build(const std::vector<unsigned>& text, unsigned alphabetSize);
+
+    /**
+     * Builds the LCP array (Kasai et al.), lcp[i] is the length of the longest
+     * common prefix of the suffixes sa[i - 1] and sa[i], lcp[0] is 0.
+     */
+    std::vector<unsigned> BuildLcp(const std::vector<unsigned>& text, const std::vector<unsigned>& sa);
+
+    /**
+     * Finds all duplicated blocks of [first, last) in a single pass over the
+     * concatenated line hashes of all files. The blocks are the same ones
+     * the pairwise comparison finds, ordered the same way.
+     */
+    std::vector<Block> FindBlocks(
+        std::vector<SourceFile>::const_iterator first,
+        std::vector<SourceFile>::const_iterator last,
+        const Options& options);
+}
+
+#endif
@@ -2,11 +2,9 @@
 #define _UTIL_H_
 
 #include "SourceFile.h"
+#include <functional>
 #include <string>
-
-namespace CstyleUtils {
-  std::string RemoveSingleLineComments(const std::string& line);
-}
+#include <string_view>
 
 namespace StringUtil {
   /**
@@ -17,6 +15,14 @@ namespace StringUtil {
    */
   std::string Trim(const std::string& input);
 
+  /**
+   * Trim string without copying it
+   *
+   * @param input  string to trim
+   * @return returns the trimmed part of input
+   */
+  std::string_view Trim(std::string_view input);
+
   /**
    * Split string
    *
@@ -34,6 +40,16 @@ namespace StringUtil {
 
   std::string ToLower(const std::string& s);
 
+  /**
+   * Find a lowercase string in text, ignoring the case of text
+   *
+   * @param text  string to search
+   * @param lower  lowercase string to find
+   * @param pos  position to start at
+   * @return returns the position of lower like std::string::find
+   */
+  std::size_t FindNoCase(std::string_view text, std::string_view lower, std::size_t pos = 0);
+
   std::string GetFileExtension(const std::string& filename);
 
   std::string GetFilenamePart(const std::string& fullpath);
@@ -43,6 +59,11 @@ namespace StringUtil {
 
 namespace FileSystem {
   std::vector<std::string> LoadFileList(const std::string& listFilename);
+
+  /**
+   * Calls f for every line of the file list as soon as it is read
+   */
+  void ForEachListedFile(const std::string& listFilename, const std::function<void(const std::string&)>& f);
 }
 
 #endif
@@ -0,0 +1,46 @@
+#ifndef _WINDOWINDEX_H_
+#define _WINDOWINDEX_H_
+
+#include "Block.h"
+#include "Options.h"
+#include "SourceFile.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Index of the rolling fingerprints of every window of consecutive lines.
+ * Two files can only share a block of at least windowSize lines if they
+ * share one of its windows, so the matching windows are the only places
+ * where blocks are searched for.
+ */
+class WindowIndex {
+    struct Window {
+        std::uint64_t fingerprint;
+        unsigned file;
+        unsigned line;
+
+        bool operator<(const Window& other) const;
+    };
+
+    std::vector<SourceFile>::const_iterator m_first;
+    unsigned m_windowSize;
+    std::vector<Window> m_windows;
+
+    template <typename F>
+    void ForEachWindow(const SourceFile& file, F f) const;
+
+public:
+    WindowIndex(
+        std::vector<SourceFile>::const_iterator first,
+        std::vector<SourceFile>::const_iterator last,
+        unsigned windowSize);
+
+    /**
+     * Finds the blocks of the file with itself and with all files after it,
+     * ordered like the pairwise comparison reports them.
+     */
+    std::vector<Block> FindBlocks(std::vector<SourceFile>::const_iterator file, const Options& options) const;
+};
+
+#endif
@@ -21,6 +21,7 @@ public:
         int count,
         const SourceFile& source1,
         const SourceFile& source2) override;
+    void ReportClass(const CloneClass& cloneClass) override;
 };
 
 #endif
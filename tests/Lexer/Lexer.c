@@ -0,0 +1,17 @@
+const char* url = "http://example.com/*"; // a comment
+char slash = '/'; char star = '*'; /* a comment */
+const char* quoted = "say \"/*\" twice";
+int a = 1; /* outer /* inner */ int b = 2;
+int c = 3; */ int d = 4;
+const char* unclosed = "no end
+int e = 5; // gone */ int f = 6;
+
+int g = 7;
+
+const char* url = "http://example.com/*"; // another comment
+char slash = '/'; char star = '*'; /* another comment */
+const char* quoted = "say \"/*\" twice";
+int a = 1; /* outer /* inner */ int b = 2;
+int c = 3; */ int d = 4;
+const char* unclosed = "no end
+int e = 5; // gone */ int f = 6;
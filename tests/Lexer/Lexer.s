@@ -0,0 +1,11 @@
+msg1: .ascii "a;b\"c;d" ; comment
+msg2: .ascii "x;y" ; comment
+    movl $';', %eax ; a semicolon
+    movl $0, %ebx
+    int $0x80
+
+msg1: .ascii "a;b\"c;d" ; other comment
+msg2: .ascii "x;y"
+    movl $';', %eax ; a semicolon
+    movl $0, %ebx
+    int $0x80
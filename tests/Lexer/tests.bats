@@ -0,0 +1,17 @@
+#!/bin/bash
+
+@test "Lexer" {
+    run ./build/duplo tests/Lexer/Lexer.lst out.txt
+    [ "$status" -eq 1 ]
+    [ "${lines[1]}" = "tests/Lexer/Lexer.c found: 1 block(s)" ]
+    [ "${lines[2]}" = "tests/Lexer/Lexer.s found: 1 block(s)" ]
+    [ "${lines[3]}" = "tests/Lexer/Lexer.vb found: 1 block(s)" ]
+}
+
+@test "Lexer out.txt" {
+    run diff <(cat tests/Lexer/expected.log) <(./build/duplo tests/Lexer/Lexer.lst -)
+    [ "$status" -eq 0 ]
+    printf 'Lines:\n'
+    printf 'lines %s\n' "${lines[@]}" >&2
+    printf 'output %s\n' "${output[@]}" >&2
+}
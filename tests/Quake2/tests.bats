@@ -7,3 +7,34 @@
     printf 'lines %s\n' "${lines[@]}" >&2
     printf 'output %s\n' "${output[@]}" >&2
 }
+
+@test "g_chase.c suffix array" {
+    run diff <(cat tests/Quake2/expected.log) <(./build/duplo -sa tests/Quake2/files.lst -)
+    [ "$status" -eq 0 ]
+}
+
+@test "g_chase.c window seeds" {
+    run diff <(cat tests/Quake2/expected.log) <(./build/duplo -ws tests/Quake2/files.lst -)
+    [ "$status" -eq 0 ]
+}
+
+@test "g_chase.c multiple threads" {
+    run diff <(cat tests/Quake2/expected.log) <(./build/duplo -j 4 tests/Quake2/files.lst -)
+    [ "$status" -eq 0 ]
+}
+
+@test "g_chase.c changed files" {
+    run diff <(cat tests/Quake2/expected.log) <(./build/duplo -changed tests/Quake2/files.lst tests/Quake2/files.lst -)
+    [ "$status" -eq 0 ]
+}
+
+@test "g_chase.c verified" {
+    run diff <(cat tests/Quake2/expected.log) <(./build/duplo -verify tests/Quake2/files.lst -)
+    [ "$status" -eq 0 ]
+}
+
+@test "g_chase.c changed files with maximum number of files" {
+    run ./build/duplo -changed tests/Quake2/files.lst -n 1 tests/Quake2/files.lst out.txt
+    [ "$status" -eq 1 ]
+    [ "$output" = "-changed can't be combined with -sa, -ws, -p or -n" ]
+}
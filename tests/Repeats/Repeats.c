@@ -0,0 +1,31 @@
+void fill_table(int* table)
+{
+    table[0] = 0;
+    table[0] = 0;
+    table[0] = 0;
+    table[0] = 0;
+    table[0] = 0;
+    table[0] = 0;
+    table[0] = 0;
+    table[0] = 0;
+    table[0] = 0;
+    table[0] = 0;
+}
+
+int dispatch(int op)
+{
+    switch (op) {
+    case 1: first_handler(op);
+        break;
+    case 2: second_handler(op);
+        break;
+    case 1: first_handler(op);
+        break;
+    case 2: second_handler(op);
+        break;
+    case 1: first_handler(op);
+        break;
+    case 2: second_handler(op);
+        break;
+    }
+}
@@ -0,0 +1,35 @@
+#!/bin/bash
+
+@test "Repeats.c" {
+    run ./build/duplo tests/Repeats/Repeats.lst out.txt
+    [ "$status" -eq 1 ]
+    [ "${lines[1]}" = "tests/Repeats/Repeats.c found: 8 block(s)" ]
+}
+
+@test "Repeats.c window seeds" {
+    run diff <(./build/duplo tests/Repeats/Repeats.lst -) <(./build/duplo -ws tests/Repeats/Repeats.lst -)
+    [ "$status" -eq 0 ]
+}
+
+@test "Repeats.c window seeds with short blocks" {
+    run diff <(./build/duplo -ml 2 tests/Repeats/Repeats.lst -) <(./build/duplo -ws -ml 2 tests/Repeats/Repeats.lst -)
+    [ "$status" -eq 0 ]
+}
+
+@test "Repeats.c pruned" {
+    run diff <(cat tests/Repeats/expected.log) <(./build/duplo -prune tests/Repeats/Repeats.lst -)
+    [ "$status" -eq 0 ]
+    printf 'Lines:\n'
+    printf 'lines %s\n' "${lines[@]}" >&2
+    printf 'output %s\n' "${output[@]}" >&2
+}
+
+@test "Repeats.c pruned suffix array" {
+    run diff <(cat tests/Repeats/expected.log) <(./build/duplo -prune -sa tests/Repeats/Repeats.lst -)
+    [ "$status" -eq 0 ]
+}
+
+@test "Repeats.c pruned window seeds" {
+    run diff <(cat tests/Repeats/expected.log) <(./build/duplo -prune -ws tests/Repeats/Repeats.lst -)
+    [ "$status" -eq 0 ]
+}
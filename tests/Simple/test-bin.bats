@@ -0,0 +1,51 @@
+#!/bin/bash
+
+@test "LineNumbers.c" {
+    run ./build/duplo -bin tests/Simple/LineNumbers.lst out.bin
+    [ "$status" -eq 1 ]
+    [ "${lines[0]}" = "Loading and hashing files ... 2 done." ]
+}
+
+@test "LineNumbers.c out.bin converted to json" {
+    run diff <(cat tests/Simple/expected-json.log) <(./build/duplo -bin tests/Simple/LineNumbers.lst - | ./build/duplo-report -)
+    [ "$status" -eq 0 ]
+    printf 'Lines:\n'
+    printf 'lines %s\n' "${lines[@]}" >&2
+    printf 'output %s\n' "${output[@]}" >&2
+}
+
+@test "LineNumbers.c out.bin without blocks converted to json" {
+    run bash -c "./build/duplo -bin -ml 100 tests/Simple/LineNumbers.lst - | ./build/duplo-report -"
+    [ "$status" -eq 0 ]
+    [ "$output" = "null" ]
+}
+
+@test "report with another magic" {
+    run bash -c "printf 'DUPLOXML\x02E' | ./build/duplo-report -"
+    [ "$status" -eq 1 ]
+    [ "$output" = "Error: Not a duplo report" ]
+}
+
+@test "report of a later version" {
+    run bash -c "printf 'DUPLOREP\x09E' | ./build/duplo-report -"
+    [ "$status" -eq 1 ]
+    [ "$output" = "Error: Unsupported report version 9" ]
+}
+
+@test "report with an invalid record" {
+    run bash -c "printf 'DUPLOREP\x02X' | ./build/duplo-report -"
+    [ "$status" -eq 1 ]
+    [ "$output" = "Error: Invalid record in report" ]
+}
+
+@test "report with a block of an unknown text" {
+    run bash -c "printf 'DUPLOREP\x02F\x01aB\x00\x00\x01\x04\x00\x05\x08E' | ./build/duplo-report -"
+    [ "$status" -eq 1 ]
+    [ "$output" = "Error: Invalid id in report" ]
+}
+
+@test "report that ends too early" {
+    run bash -c "./build/duplo -bin tests/Simple/LineNumbers.lst - | head -c 40 | ./build/duplo-report -"
+    [ "$status" -eq 1 ]
+    [ "$output" = "Error: Unexpected end of report" ]
+}
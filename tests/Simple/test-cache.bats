@@ -0,0 +1,37 @@
+#!/bin/bash
+
+setup() {
+    dir=$(mktemp -d)
+}
+
+teardown() {
+    rm -rf "$dir"
+}
+
+@test "LineNumbers.c cached" {
+    run ./build/duplo -cache "$dir/cache" tests/Simple/LineNumbers.lst out.txt
+    [ "$status" -eq 1 ]
+    [ "$(ls "$dir/cache" | wc -l)" -eq 1 ]
+    run diff <(cat tests/Simple/expected.log) <(./build/duplo -cache "$dir/cache" tests/Simple/LineNumbers.lst -)
+    [ "$status" -eq 0 ]
+}
+
+@test "LineNumbers.c cold and warm cache" {
+    run diff <(./build/duplo -cache "$dir/cache" tests/Simple/LineNumbers.lst -) <(./build/duplo -cache "$dir/cache" tests/Simple/LineNumbers.lst -)
+    [ "$status" -eq 0 ]
+}
+
+@test "LineNumbers.c changed after it was cached" {
+    cp tests/Simple/LineNumbers.c "$dir"
+    echo "$dir/LineNumbers.c" > "$dir/files.lst"
+    run ./build/duplo -cache "$dir/cache" "$dir/files.lst" out.txt
+    [ "${lines[1]}" = "$dir/LineNumbers.c found: 1 block(s)" ]
+    touch -r "$dir/cache/"*.fp "$dir/stamp"
+    sleep 1
+    printf 'BBBBB\nCCCCC\nDDDDD\nEEEEE\n' >> "$dir/LineNumbers.c"
+    run ./build/duplo -cache "$dir/cache" "$dir/files.lst" out.txt
+    [ "${lines[1]}" = "$dir/LineNumbers.c found: 3 block(s)" ]
+    [ "$dir/cache/"*.fp -nt "$dir/stamp" ]
+    run diff <(./build/duplo "$dir/files.lst" -) <(./build/duplo -cache "$dir/cache" "$dir/files.lst" -)
+    [ "$status" -eq 0 ]
+}
@@ -13,3 +13,9 @@
     printf 'lines %s\n' "${lines[@]}" >&2
     printf 'output %s\n' "${output[@]}" >&2
 }
+
+@test "LineNumbers.c out.json without blocks" {
+    run ./build/duplo -json -ml 100 tests/Simple/LineNumbers.lst -
+    [ "$status" -eq 0 ]
+    [ "$output" = "null" ]
+}
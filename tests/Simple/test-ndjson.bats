@@ -0,0 +1,15 @@
+#!/bin/bash
+
+@test "LineNumbers.c" {
+    run ./build/duplo -ndjson tests/Simple/LineNumbers.lst out.ndjson
+    [ "$status" -eq 1 ]
+    [ "${lines[0]}" = "Loading and hashing files ... 2 done." ]
+}
+
+@test "LineNumbers.c out.ndjson" {
+    run diff <(cat tests/Simple/expected-ndjson.log) <(./build/duplo -ndjson tests/Simple/LineNumbers.lst -)
+    [ "$status" -eq 0 ]
+    printf 'Lines:\n'
+    printf 'lines %s\n' "${lines[@]}" >&2
+    printf 'output %s\n' "${output[@]}" >&2
+}
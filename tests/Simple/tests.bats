@@ -14,3 +14,65 @@
     printf 'lines %s\n' "${lines[@]}" >&2
     printf 'output %s\n' "${output[@]}" >&2
 }
+
+@test "LineNumbers.c suffix array" {
+    run diff <(cat tests/Simple/expected.log) <(./build/duplo -sa tests/Simple/LineNumbers.lst -)
+    [ "$status" -eq 0 ]
+}
+
+@test "LineNumbers.c window seeds" {
+    run diff <(cat tests/Simple/expected.log) <(./build/duplo -ws tests/Simple/LineNumbers.lst -)
+    [ "$status" -eq 0 ]
+}
+
+@test "LineNumbers.c clone classes" {
+    run diff <(cat tests/Simple/expected-classes.log) <(./build/duplo -classes tests/Simple/LineNumbers.lst -)
+    [ "$status" -eq 0 ]
+}
+
+@test "LineNumbers.c pipelined" {
+    run diff <(./build/duplo tests/Simple/LineNumbers.lst - | tail -n +2 | sort) <(./build/duplo -p -j 4 tests/Simple/LineNumbers.lst - | tail -n +2 | sort)
+    [ "$status" -eq 0 ]
+}
+
+@test "LineNumbers.c pipelined from stdin" {
+    run diff <(./build/duplo tests/Simple/LineNumbers.lst - | tail -n +2 | sort) <(./build/duplo -p - - < tests/Simple/LineNumbers.lst | tail -n +2 | sort)
+    [ "$status" -eq 0 ]
+}
+
+# the cache keeps the lines of a file that is changed without a new size or
+# time, so the text read for a block differs from the lines that were loaded
+change_cached_file() {
+    dir=$(mktemp -d)
+    cp tests/Simple/LineNumbers.c "$dir"
+    echo "$dir/LineNumbers.c" > "$dir/files.lst"
+    ./build/duplo -cache "$dir/cache" "$dir/files.lst" out.txt || true
+    touch -r "$dir/LineNumbers.c" "$dir/stamp"
+    sed -i '1s/AAAAA/AAAAX/' "$dir/LineNumbers.c"
+    touch -r "$dir/stamp" "$dir/LineNumbers.c"
+}
+
+teardown() {
+    [ -z "$dir" ] || rm -rf "$dir"
+}
+
+@test "LineNumbers.c changed while verified" {
+    change_cached_file
+    run ./build/duplo -verify -cache "$dir/cache" "$dir/files.lst" out.txt
+    [ "$status" -eq 1 ]
+    [ "${lines[1]}" = "Error: File changed while it was scanned: $dir/LineNumbers.c" ]
+}
+
+@test "LineNumbers.c changed while verified by window seeds" {
+    change_cached_file
+    run ./build/duplo -verify -ws -cache "$dir/cache" "$dir/files.lst" out.txt
+    [ "$status" -eq 1 ]
+    [ "${lines[1]}" = "Error: File changed while it was scanned: $dir/LineNumbers.c" ]
+}
+
+@test "LineNumbers.c changed while compared while loading" {
+    change_cached_file
+    run ./build/duplo -p -verify -cache "$dir/cache" "$dir/files.lst" out.txt
+    [ "$status" -eq 1 ]
+    [ "${lines[1]}" = "Error: File changed while it was scanned: $dir/LineNumbers.c" ]
+}
@@ -0,0 +1,10 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+int main(int argc, char **argv)
+{
+    printf("%d arguments\n", argc);
+    return argc > 1 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,12 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+int queue_push(int *stack, int *top, int value)
+{
+    if (*top >= STACK_SIZE)
+        return -1;
+    stack[(*top)++] = value;
+    return 0;
+}
@@ -0,0 +1,48 @@
+#!/bin/bash
+
+@test "StopLines" {
+    run ./build/duplo tests/StopLines/StopLines.lst out.txt
+    [ "$status" -eq 1 ]
+    [ "${lines[1]}" = "tests/StopLines/Stack.c found: 3 block(s)" ]
+    [ "${lines[2]}" = "tests/StopLines/Queue.c found: 1 block(s)" ]
+}
+
+@test "StopLines ignored" {
+    run ./build/duplo -sl 2 tests/StopLines/StopLines.lst out.txt
+    [ "$status" -eq 1 ]
+    [ "${lines[1]}" = "Ignoring 4 line(s) found in more than 2 files when choosing file pairs" ]
+    [ "${lines[6]}" = "tests/StopLines/Stack.c found: 1 block(s)" ]
+    [ "${lines[7]}" = "tests/StopLines/Queue.c nothing found." ]
+    [ "${lines[8]}" = "tests/StopLines/Main.c nothing found." ]
+}
+
+@test "StopLines ignored out.txt" {
+    run diff <(cat tests/StopLines/expected.log) <(./build/duplo -sl 2 tests/StopLines/StopLines.lst -)
+    [ "$status" -eq 0 ]
+    printf 'Lines:\n'
+    printf 'lines %s\n' "${lines[@]}" >&2
+    printf 'output %s\n' "${output[@]}" >&2
+}
+
+@test "StopLines ignored multiple threads" {
+    run diff <(cat tests/StopLines/expected.log) <(./build/duplo -sl 2 -j 4 tests/StopLines/StopLines.lst -)
+    [ "$status" -eq 0 ]
+}
+
+@test "StopLines with suffix array" {
+    run ./build/duplo -sl 2 -sa tests/StopLines/StopLines.lst out.txt
+    [ "$status" -eq 1 ]
+    [ "$output" = "-sl only applies when comparing file pairs" ]
+}
+
+@test "StopLines with window seeds" {
+    run ./build/duplo -sl 2 -ws tests/StopLines/StopLines.lst out.txt
+    [ "$status" -eq 1 ]
+    [ "$output" = "-sl only applies when comparing file pairs" ]
+}
+
+@test "StopLines pipelined" {
+    run ./build/duplo -sl 2 -p tests/StopLines/StopLines.lst out.txt
+    [ "$status" -eq 1 ]
+    [ "$output" = "-p can't be combined with -sa, -ws or -sl" ]
+}
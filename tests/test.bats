@@ -21,14 +21,39 @@
     [ "${lines[14]}" = "       -j               number of threads to use (default is 1)" ]
     [ "${lines[15]}" = "       -ip              ignore preprocessor directives" ]
     [ "${lines[16]}" = "       -d               ignore file pairs with same name" ]
-    [ "${lines[17]}" = "       -xml             output file in XML" ]
-    [ "${lines[18]}" = "       -json            output file in JSON format" ]
-    [ "${lines[19]}" = "       INPUT_FILELIST   input filelist (specify '-' to read from stdin)" ]
-    [ "${lines[20]}" = "       OUTPUT_FILE      output file (specify '-' to output to stdout)" ]
-    [ "${lines[21]}" = "VERSION" ]
-    [ "${lines[23]}" = "AUTHORS" ]
-    [ "${lines[24]}" = "       Daniel Lidstrom (dlidstrom@gmail.com)" ]
-    [ "${lines[25]}" = "       Christian M. Ammann (cammann@giants.ch)" ]
-    [ "${lines[26]}" = "       Trevor D'Arcy-Evans (tdarcyevans@hotmail.com)" ]
-    [ "${lines[27]}" = "       Christos Gkantidis (cgkantid@proton.me)" ]
+    [ "${lines[17]}" = "       -sa              find duplicates with a suffix array over all files" ]
+    [ "${lines[18]}" = "                        instead of comparing file pairs" ]
+    [ "${lines[19]}" = "       -ws              only compare lines around windows of -ml lines" ]
+    [ "${lines[20]}" = "                        that are shared by both files" ]
+    [ "${lines[21]}" = "       -sl              ignore lines found in more than N files when" ]
+    [ "${lines[22]}" = "                        choosing file pairs, blocks need other lines too" ]
+    [ "${lines[23]}" = "                        (default is 0, all lines are used)" ]
+    [ "${lines[24]}" = "       -p               compare every file with the files before it" ]
+    [ "${lines[25]}" = "                        while loading, blocks are grouped by the" ]
+    [ "${lines[26]}" = "                        later file" ]
+    [ "${lines[27]}" = "       -cache           directory to keep the hashed lines of files in," ]
+    [ "${lines[28]}" = "                        unchanged files are not read again" ]
+    [ "${lines[29]}" = "       -changed         file with a list of changed files, only blocks" ]
+    [ "${lines[30]}" = "                        in one of them are reported, the other" ]
+    [ "${lines[31]}" = "                        files are not compared with each other" ]
+    [ "${lines[32]}" = "       -verify          compare the text of the lines of every block," ]
+    [ "${lines[33]}" = "                        lines that only have the same hash end it" ]
+    [ "${lines[34]}" = "       -prune           leave out blocks that lie within a longer block" ]
+    [ "${lines[35]}" = "                        of the same files, repeats are reported once" ]
+    [ "${lines[36]}" = "       -classes         report the blocks with the same lines once, as" ]
+    [ "${lines[37]}" = "                        a clone class with all of their places" ]
+    [ "${lines[38]}" = "       -xml             output file in XML" ]
+    [ "${lines[39]}" = "       -json            output file in JSON format" ]
+    [ "${lines[40]}" = "       -ndjson          output file in JSON format, one line per block" ]
+    [ "${lines[41]}" = "       -bin             output file in a compact binary format, the text" ]
+    [ "${lines[42]}" = "                        of a block is only written once, duplo-report" ]
+    [ "${lines[43]}" = "                        converts it to JSON" ]
+    [ "${lines[44]}" = "       INPUT_FILELIST   input filelist (specify '-' to read from stdin)" ]
+    [ "${lines[45]}" = "       OUTPUT_FILE      output file (specify '-' to output to stdout)" ]
+    [ "${lines[46]}" = "VERSION" ]
+    [ "${lines[48]}" = "AUTHORS" ]
+    [ "${lines[49]}" = "       Daniel Lidstrom (dlidstrom@gmail.com)" ]
+    [ "${lines[50]}" = "       Christian M. Ammann (cammann@giants.ch)" ]
+    [ "${lines[51]}" = "       Trevor D'Arcy-Evans (tdarcyevans@hotmail.com)" ]
+    [ "${lines[52]}" = "       Christos Gkantidis (cgkantid@proton.me)" ]
 }
@@ -0,0 +1,177 @@
+#include "BinaryReport.h"
+#include "JsonWriter.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Converts a report written with duplo -bin to the JSON of duplo -json.
+
+namespace {
+    template <typename T>
+    const T& Lookup(const std::vector<T>& table, std::uint64_t id) {
+        if (id >= table.size()) {
+            throw std::runtime_error("Error: Invalid id in report");
+        }
+        return table[id];
+    }
+
+    void WriteLines(JsonWriter& writer, const std::vector<std::string>& lines) {
+        writer.Key("LineCount");
+        writer.Number(static_cast<std::int64_t>(lines.size()));
+        writer.Key("Lines");
+        writer.BeginArray();
+        for (auto const& line : lines) {
+            writer.String(line);
+        }
+        writer.EndArray();
+    }
+
+    std::int64_t ReadLineNumber(std::istream& in) {
+        return static_cast<std::int64_t>(BinaryReport::ReadNumber(in));
+    }
+
+    void Convert(std::istream& in, std::ostream& out) {
+        std::string magic(BinaryReport::MAGIC.size(), '\0');
+        if (!in.read(magic.data(), magic.size()) || magic != BinaryReport::MAGIC) {
+            throw std::runtime_error("Error: Not a duplo report");
+        }
+        auto version = BinaryReport::ReadNumber(in);
+        if (version < 1 || version > BinaryReport::VERSION) {
+            throw std::runtime_error("Error: Unsupported report version " + std::to_string(version));
+        }
+
+        // the members are written in the order of duplo -json
+        std::vector<std::string> files;
+        std::vector<std::vector<std::string>> texts;
+        JsonWriter writer(true);
+        bool empty = true;
+        for (;;) {
+            auto record = BinaryReport::ReadRecord(in);
+            switch (record) {
+            case BinaryReport::Record::File:
+                files.push_back(BinaryReport::ReadString(in));
+                break;
+            case BinaryReport::Record::Text: {
+                auto& lines = texts.emplace_back();
+                auto count = BinaryReport::ReadNumber(in);
+                for (std::uint64_t i = 0; i < count; i++) {
+                    lines.push_back(BinaryReport::ReadString(in));
+                }
+                break;
+            }
+            case BinaryReport::Record::Block: {
+                auto const& lines = Lookup(texts, BinaryReport::ReadNumber(in));
+                auto const& file1 = Lookup(files, BinaryReport::ReadNumber(in));
+                auto start1 = ReadLineNumber(in);
+                auto end1 = ReadLineNumber(in);
+                auto const& file2 = Lookup(files, BinaryReport::ReadNumber(in));
+                auto start2 = ReadLineNumber(in);
+                auto end2 = ReadLineNumber(in);
+
+                if (empty) {
+                    writer.BeginArray();
+                    empty = false;
+                }
+                writer.BeginObject();
+                writer.Key("EndLineNumber1");
+                writer.Number(end1);
+                writer.Key("EndLineNumber2");
+                writer.Number(end2);
+                WriteLines(writer, lines);
+                writer.Key("SourceFile1");
+                writer.String(file1);
+                writer.Key("SourceFile2");
+                writer.String(file2);
+                writer.Key("StartLineNumber1");
+                writer.Number(start1);
+                writer.Key("StartLineNumber2");
+                writer.Number(start2);
+                writer.EndObject();
+                writer.WriteTo(out);
+                break;
+            }
+            case BinaryReport::Record::Class: {
+                auto const& lines = Lookup(texts, BinaryReport::ReadNumber(in));
+                auto numLocations = BinaryReport::ReadNumber(in);
+
+                if (empty) {
+                    writer.BeginArray();
+                    empty = false;
+                }
+                writer.BeginObject();
+                WriteLines(writer, lines);
+                writer.Key("Locations");
+                writer.BeginArray();
+                for (std::uint64_t i = 0; i < numLocations; i++) {
+                    auto const& file = Lookup(files, BinaryReport::ReadNumber(in));
+                    auto start = ReadLineNumber(in);
+                    auto end = ReadLineNumber(in);
+                    writer.BeginObject();
+                    writer.Key("EndLineNumber");
+                    writer.Number(end);
+                    writer.Key("SourceFile");
+                    writer.String(file);
+                    writer.Key("StartLineNumber");
+                    writer.Number(start);
+                    writer.EndObject();
+                }
+                writer.EndArray();
+                writer.EndObject();
+                writer.WriteTo(out);
+                break;
+            }
+            case BinaryReport::Record::End:
+                if (empty) {
+                    writer.Null();
+                } else {
+                    writer.EndArray();
+                }
+                writer.WriteTo(out);
+                out << '\n';
+                return;
+            default:
+                throw std::runtime_error("Error: Invalid record in report");
+            }
+        }
+    }
+}
+
+int main(int argc, const char* argv[]) {
+    if (argc < 2 || argc > 3) {
+        std::cout << "usage: duplo-report REPORT_FILE [OUTPUT_FILE]\n\n";
+        std::cout << "Converts a report of duplo -bin to the JSON of duplo -json.\n";
+        std::cout << "Specify '-' to read from stdin or to output to stdout (default).\n";
+        return EXIT_FAILURE;
+    }
+
+    try {
+        std::string reportFilename(argv[1]);
+        std::string outputFilename(argc == 3 ? argv[2] : "-");
+        std::ifstream reportFile;
+        if (reportFilename != "-") {
+            reportFile.open(reportFilename, std::ios::in | std::ios::binary);
+            if (!reportFile) {
+                throw std::runtime_error("Error: Can't open file: " + reportFilename);
+            }
+        }
+        std::ofstream outputFile;
+        if (outputFilename != "-") {
+            outputFile.open(outputFilename, std::ios::out | std::ios::binary);
+            if (!outputFile) {
+                throw std::runtime_error("Error: Can't open file: " + outputFilename);
+            }
+        }
+        std::istream& in = reportFilename != "-" ? reportFile : std::cin;
+        std::ostream& out = outputFilename != "-" ? outputFile : std::cout;
+        Convert(in, out);
+        return EXIT_SUCCESS;
+    }
+    catch (const std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}